@@ -0,0 +1,210 @@
+#ifndef SJTU_COW_LIST_HPP
+#define SJTU_COW_LIST_HPP
+
+#include "list.hpp"
+
+#include <cstddef>
+
+namespace sjtu {
+/**
+ * a copy-on-write list: copies share one node chain and cost O(1);
+ * the first modification through a shared copy gives it a private deep copy.
+ * once a mutable iterator (begin() / end(), or insert / erase by iterator) was handed out the chain is
+ * no longer shared by later copies, since a write through that iterator must not show up in snapshots;
+ * clear() lifts this again. insert / erase by index edit by position and keep the chain shareable.
+ * a modification that detaches (push_back, pop_front, sort ...) leaves the const_iterators this object
+ * handed out before it pointing into the snapshot still held by the other copies, not into this object.
+ * reference counting is not atomic: a cow_list and its copies must stay on one thread.
+ */
+template<typename T>
+class cow_list {
+public:
+    typedef typename list<T>::iterator iterator;
+    typedef typename list<T>::const_iterator const_iterator;
+
+protected:
+    struct rep {
+        list<T> data;
+        size_t refs;
+        bool shareable; // false while mutable iterators may be around
+
+        rep(): data(), refs(1), shareable(true) {}
+        explicit rep(const list<T> &other): data(other), refs(1), shareable(true) {}
+    };
+
+    rep *body;
+
+    void release() {
+        if (--body->refs == 0) delete body;
+    }
+    /**
+     * share other's chain, or copy it if it cannot be shared
+     */
+    void attach(rep *other) {
+        if (other->shareable) {
+            body = other;
+            ++body->refs;
+        } else {
+            body = new rep(other->data);
+        }
+    }
+    /**
+     * make the chain private to this object before modifying it
+     */
+    void detach() {
+        if (body->refs == 1) return;
+        rep *r = new rep(body->data);
+        release();
+        body = r;
+    }
+    /**
+     * detach, and return the iterator of the private copy at the position of pos
+     */
+    iterator detach(iterator pos) {
+        if (body->refs == 1) return pos;
+        size_t idx = 0;
+        for (const_iterator it = body->data.cbegin(); !(it == pos); ++it, ++idx) {
+            if (it == body->data.cend()) throw invalid_iterator();
+        }
+        detach();
+        iterator it = body->data.begin();
+        for (size_t k = 0; k < idx; ++k) ++it;
+        return it;
+    }
+
+public:
+    cow_list(): body(new rep()) {}
+    cow_list(const cow_list &other) { attach(other.body); }
+    explicit cow_list(const list<T> &other): body(new rep(other)) {}
+    ~cow_list() { release(); }
+    cow_list &operator=(const cow_list &other) {
+        if (body == other.body) return *this;
+        rep *old = body;
+        attach(other.body);
+        if (--old->refs == 0) delete old;
+        return *this;
+    }
+
+    /**
+     * whether the node chain is currently shared with another copy
+     */
+    bool shared() const { return body->refs > 1; }
+    /**
+     * read-only view of the underlying list, never copies
+     */
+    const list<T> &view() const { return body->data; }
+
+    const T & front() const { return body->data.front(); }
+    const T & back() const { return body->data.back(); }
+    /**
+     * mutable iterators: detach, and keep the chain private until the next clear()
+     */
+    iterator begin() {
+        detach();
+        body->shareable = false;
+        return body->data.begin();
+    }
+    iterator end() {
+        detach();
+        body->shareable = false;
+        return body->data.end();
+    }
+    const_iterator cbegin() const { return body->data.cbegin(); }
+    const_iterator cend() const { return body->data.cend(); }
+    bool empty() const { return body->data.empty(); }
+    size_t size() const { return body->data.size(); }
+
+    void clear() {
+        if (body->refs > 1) {
+            release();
+            body = new rep();
+            return;
+        }
+        body->data.clear();
+        body->shareable = true;
+    }
+    /**
+     * insert / erase return mutable iterators, so like begin() they keep the chain private until the next clear();
+     * the overloads taking an index below do not
+     */
+    iterator insert(iterator pos, const T &value) {
+        pos = detach(pos);
+        body->shareable = false;
+        return body->data.insert(pos, value);
+    }
+    iterator erase(iterator pos) {
+        pos = detach(pos);
+        body->shareable = false;
+        return body->data.erase(pos);
+    }
+    /**
+     * insert value before the element at index (index == size() appends), and keep the chain shareable
+     * return a const_iterator pointing to the inserted value
+     * throw index_out_of_bound if index > size()
+     */
+    const_iterator insert(size_t index, const T &value) {
+        if (index > body->data.size()) throw index_out_of_bound();
+        detach();
+        iterator it = body->data.begin();
+        for (size_t k = 0; k < index; ++k) ++it;
+        return body->data.insert(it, value);
+    }
+    /**
+     * remove the element at index, and keep the chain shareable
+     * return a const_iterator pointing to the following element (cend() if it was the last)
+     * throw index_out_of_bound if index >= size()
+     */
+    const_iterator erase(size_t index) {
+        if (index >= body->data.size()) throw index_out_of_bound();
+        detach();
+        iterator it = body->data.begin();
+        for (size_t k = 0; k < index; ++k) ++it;
+        return body->data.erase(it);
+    }
+    void push_back(const T &value) {
+        detach();
+        body->data.push_back(value);
+    }
+    void pop_back() {
+        if (body->data.empty()) throw container_is_empty();
+        detach();
+        body->data.pop_back();
+    }
+    void push_front(const T &value) {
+        detach();
+        body->data.push_front(value);
+    }
+    void pop_front() {
+        if (body->data.empty()) throw container_is_empty();
+        detach();
+        body->data.pop_front();
+    }
+    void sort() {
+        if (body->data.size() <= 1) return;
+        detach();
+        body->data.sort();
+    }
+    /**
+     * as list::merge; other becomes empty. a shared other is copied first, its snapshots keep their elements
+     */
+    void merge(cow_list &other) {
+        if (this == &other || other.empty()) return;
+        detach();
+        other.detach();
+        body->data.merge(other.body->data);
+    }
+    void reverse() {
+        if (body->data.size() <= 1) return;
+        detach();
+        body->data.reverse();
+    }
+    void unique() {
+        if (body->data.size() <= 1) return;
+        detach();
+        body->data.unique();
+    }
+};
+
+}
+
+#endif //SJTU_COW_LIST_HPP
@@ -0,0 +1,180 @@
+#define SJTU_LIST_ENABLE_INITIALIZER_LIST
+
+#include "class-bint.hpp"
+#include "list.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <vector>
+
+const int N = 5e4;
+
+template<typename T>
+bool equal(const std::list<T> &x, const sjtu::list<T> &y) {
+    if (x.size() != y.size())
+        return false;
+    typename std::list<T>::const_iterator itx = x.cbegin();
+    typename sjtu::list<T>::const_iterator ity = y.cbegin();
+    for (; itx != x.cend() && ity != y.cend(); ++itx, ++ity)
+        if (!(*itx == *ity))
+            return false;
+    return ity == y.cend();
+}
+
+int budget = -1; // copies left before Fragile throws, -1 for no limit
+
+class Fragile {
+public:
+    int val;
+    Fragile(int v): val(v) {}
+    Fragile(const Fragile &other): val(other.val) {
+        if (budget == 0) throw 1;
+        if (budget > 0) --budget;
+    }
+    bool operator==(const Fragile &rhs) const { return val == rhs.val; }
+};
+
+bool testRangeConstructor() {
+    std::vector<int> src;
+    for (int i = 0; i < N; ++i)
+        src.push_back(rand());
+    std::list<int> ans(src.begin(), src.end());
+    sjtu::list<int> myList(src.begin(), src.end());
+    if (!equal(ans, myList))
+        return false;
+    sjtu::list<int> other(myList.cbegin(), myList.cend());
+    if (!equal(ans, other))
+        return false;
+    const int arr[] = {5, 4, 3};
+    sjtu::list<int> small(arr, arr + 3), none(arr, arr);
+    std::list<int> smallAns(arr, arr + 3);
+    return equal(smallAns, small) && none.empty() && none.begin() == none.end();
+}
+
+bool testFillConstructor() {
+    std::list<int> ans(N, 7);
+    sjtu::list<int> myList(N, 7), none(0, 7);
+    sjtu::list<long long> count(10, 3);
+    if (!equal(ans, myList) || !none.empty() || count.size() != 10 || count.back() != 3)
+        return false;
+    myList.push_front(1);
+    myList.pop_back();
+    ans.push_front(1);
+    ans.pop_back();
+    return equal(ans, myList);
+}
+
+bool testInitializerList() {
+    sjtu::list<int> myList = {3, 1, 4, 1, 5};
+    std::list<int> ans = {3, 1, 4, 1, 5};
+    if (!equal(ans, myList))
+        return false;
+    myList.assign({2, 7});
+    ans.assign({2, 7});
+    return equal(ans, myList);
+}
+
+bool testAssign() {
+    std::list<int> ans;
+    sjtu::list<int> myList;
+    for (int round = 0; round < 20; ++round) {
+        size_t n = rand() % 5000;
+        if (round % 2) {
+            std::vector<int> src;
+            for (size_t i = 0; i < n; ++i)
+                src.push_back(rand());
+            ans.assign(src.begin(), src.end());
+            myList.assign(src.begin(), src.end());
+        } else {
+            int v = rand();
+            ans.assign(n, v);
+            myList.assign(n, v);
+        }
+        if (!equal(ans, myList))
+            return false;
+        for (int i = 0; i < 10 && !ans.empty(); ++i) {
+            ans.pop_front();
+            myList.pop_front();
+            ans.push_back(i);
+            myList.push_back(i);
+        }
+    }
+    return equal(ans, myList);
+}
+
+bool testBint() {
+    std::vector<Util::Bint> src;
+    for (int i = 0; i < 1000; ++i)
+        src.push_back(Util::Bint(rand()) * Util::Bint(rand()));
+    std::list<Util::Bint> ans(src.begin(), src.end());
+    sjtu::list<Util::Bint> myList(src.begin(), src.end());
+    if (!equal(ans, myList))
+        return false;
+    myList.assign(100, src[0]);
+    std::list<Util::Bint> fill(100, src[0]);
+    return equal(fill, myList);
+}
+
+bool testException() {
+    std::vector<Fragile> src;
+    std::list<Fragile> ans;
+    budget = -1;
+    for (int i = 0; i < 1000; ++i) {
+        src.push_back(Fragile(i));
+        ans.push_back(Fragile(-i));
+    }
+    sjtu::list<Fragile> myList(ans.begin(), ans.end());
+    int caught = 0;
+    budget = 500;
+    try {
+        myList.assign(src.begin(), src.end());
+    } catch (int) {
+        ++caught;
+    }
+    budget = 10;
+    try {
+        myList.assign(100, src[3]);
+    } catch (int) {
+        ++caught;
+    }
+    budget = 10;
+    try {
+        sjtu::list<Fragile> other(src.begin(), src.end());
+    } catch (int) {
+        ++caught;
+    }
+    budget = -1;
+    return caught == 3 && equal(ans, myList);
+}
+
+int main() {
+    srand(2653);
+    bool (*testList[])() = {
+            testRangeConstructor, testFillConstructor, testInitializerList, testAssign, testBint, testException
+    };
+    const char* Messages[] = {
+            "Test 1: Testing range constructor...",
+            "Test 2: Testing fill constructor...",
+            "Test 3: Testing initializer lists...",
+            "Test 4: Testing assign()...",
+            "Test 5: Testing class-bint...",
+            "Test 6: Testing exception safety..."
+    };
+
+    bool okay = true;
+    for (int i = 0; i < sizeof(testList) / sizeof(testList[0]); ++i) {
+        printf("%s", Messages[i]);
+        if (testList[i]()){
+            printf("Passed\n");
+        } else {
+            okay = false;
+            printf("Failed\n");
+        }
+    }
+
+    if (okay)
+        printf("Congratulations, you have passed all tests!\n");
+    else printf("Unfortunately, you failed in some of the tests.\n");
+    return 0;
+}
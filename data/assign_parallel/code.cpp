@@ -0,0 +1,143 @@
+#define SJTU_LIST_ENABLE_THREADS
+
+#include "class-bint.hpp"
+#include "class-matrix.hpp"
+#include "list.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+
+const int N = 1e5;
+
+template<typename T>
+bool equal(const std::list<T> &x, const sjtu::list<T> &y) {
+    if (x.size() != y.size())
+        return false;
+    typename std::list<T>::const_iterator itx = x.cbegin();
+    typename sjtu::list<T>::const_iterator ity = y.cbegin();
+    for (; itx != x.cend() && ity != y.cend(); ++itx, ++ity)
+        if (!(*itx == *ity))
+            return false;
+    return ity == y.cend();
+}
+
+bool armed = false; // copying a Fragile holding -1 throws while set
+
+class Fragile {
+public:
+    int val;
+    Fragile(int v): val(v) {}
+    Fragile(const Fragile &other): val(other.val) {
+        if (armed && val == -1) throw 1;
+    }
+    bool operator==(const Fragile &rhs) const { return val == rhs.val; }
+};
+
+bool testThreads() {
+    std::list<int> ans;
+    sjtu::list<int> src;
+    for (int i = 0; i < N; ++i) {
+        int x = rand();
+        ans.push_back(x);
+        src.push_back(x);
+    }
+    for (unsigned threads = 0; threads <= 5; ++threads) {
+        sjtu::list<int> myList;
+        myList.push_back(-1);
+        myList.assign_parallel(src, threads);
+        if (!equal(ans, myList))
+            return false;
+        myList.pop_front();
+        myList.push_back(1);
+        if (myList.size() != (size_t)N || myList.back() != 1)
+            return false;
+    }
+    return equal(ans, src);
+}
+
+bool testSmall() {
+    sjtu::list<int> src, myList;
+    myList.push_back(5);
+    myList.assign_parallel(src, 4);
+    if (!myList.empty())
+        return false;
+    src.push_back(1);
+    src.push_back(2);
+    myList.assign_parallel(src, 8);
+    myList.assign_parallel(myList, 2);
+    return myList.size() == 2 && myList.front() == 1 && myList.back() == 2;
+}
+
+bool testBint() {
+    std::list<Util::Bint> ans;
+    sjtu::list<Util::Bint> src, myList;
+    for (int i = 0; i < 3000; ++i) {
+        Util::Bint x = Util::Bint(rand()) * Util::Bint(rand()) * Util::Bint(rand());
+        ans.push_back(x);
+        src.push_back(x);
+    }
+    myList.assign_parallel(src, 4);
+    return equal(ans, myList);
+}
+
+bool testMatrix() {
+    std::list<Diamond::Matrix<double> > ans;
+    sjtu::list<Diamond::Matrix<double> > src, myList;
+    for (int i = 0; i < 500; ++i) {
+        Diamond::Matrix<double> m(8, 8, rand() % 100);
+        ans.push_back(m);
+        src.push_back(m);
+    }
+    myList.assign_parallel(src, 3);
+    return equal(ans, myList);
+}
+
+bool testException() {
+    std::list<Fragile> ans;
+    sjtu::list<Fragile> src, myList;
+    for (int i = 0; i < 1000; ++i) {
+        src.push_back(Fragile(i == 700 ? -1 : i));
+        ans.push_back(Fragile(-i - 2));
+        myList.push_back(Fragile(-i - 2));
+    }
+    armed = true;
+    try {
+        myList.assign_parallel(src, 4);
+    } catch (int) {
+        armed = false;
+        return equal(ans, myList);
+    }
+    armed = false;
+    return false;
+}
+
+int main() {
+    srand(2653);
+    bool (*testList[])() = {
+            testThreads, testSmall, testBint, testMatrix, testException
+    };
+    const char* Messages[] = {
+            "Test 1: Testing assign_parallel() with 0 to 5 threads...",
+            "Test 2: Testing empty and short lists...",
+            "Test 3: Testing class-bint...",
+            "Test 4: Testing class-Matrix...",
+            "Test 5: Testing exception safety..."
+    };
+
+    bool okay = true;
+    for (int i = 0; i < sizeof(testList) / sizeof(testList[0]); ++i) {
+        printf("%s", Messages[i]);
+        if (testList[i]()){
+            printf("Passed\n");
+        } else {
+            okay = false;
+            printf("Failed\n");
+        }
+    }
+
+    if (okay)
+        printf("Congratulations, you have passed all tests!\n");
+    else printf("Unfortunately, you failed in some of the tests.\n");
+    return 0;
+}
@@ -0,0 +1,170 @@
+#include "class-bint.hpp"
+#include "list.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+
+const int N = 5e4;
+
+template<typename T>
+bool equal(const std::list<T> &x, const sjtu::list<T> &y) {
+    if (x.size() != y.size())
+        return false;
+    typename std::list<T>::const_iterator itx = x.cbegin();
+    typename sjtu::list<T>::const_iterator ity = y.cbegin();
+    for (; itx != x.cend() && ity != y.cend(); ++itx, ++ity)
+        if (!(*itx == *ity))
+            return false;
+    return ity == y.cend();
+}
+
+int budget = -1; // copies left before Fragile throws, -1 for no limit
+
+class Fragile {
+public:
+    int val;
+    Fragile(int v): val(v) {}
+    Fragile(const Fragile &other): val(other.val) {
+        if (budget == 0) throw 1;
+        if (budget > 0) --budget;
+    }
+    bool operator==(const Fragile &rhs) const { return val == rhs.val; }
+};
+
+template<typename T>
+void shuffleOps(std::list<T> &ans, sjtu::list<T> &myList, int ops) {
+    for (int i = 0; i < ops; ++i) {
+        int op = rand() % 4;
+        size_t k = rand() % (ans.size() + 1);
+        typename std::list<T>::iterator a = ans.begin();
+        typename sjtu::list<T>::iterator b = myList.begin();
+        for (size_t j = 0; j < k && j < 200; ++j, ++a, ++b);
+        if (op == 0 && a != ans.end()) {
+            ans.erase(a);
+            myList.erase(b);
+        } else {
+            int x = rand();
+            ans.insert(a, T(x));
+            myList.insert(b, T(x));
+        }
+    }
+}
+
+bool testCompact() {
+    std::list<int> ans;
+    sjtu::list<int> myList;
+    myList.compact();
+    if (!myList.empty())
+        return false;
+    shuffleOps(ans, myList, N);
+    myList.compact();
+    if (!equal(ans, myList))
+        return false;
+    myList.compact();
+    return equal(ans, myList) && myList.front() == ans.front() && myList.back() == ans.back();
+}
+
+bool testAfterCompact() {
+    std::list<int> ans;
+    sjtu::list<int> myList;
+    shuffleOps(ans, myList, 5000);
+    myList.compact();
+    shuffleOps(ans, myList, 5000);
+    if (!equal(ans, myList))
+        return false;
+    while (ans.size() > 10) {
+        ans.pop_front();
+        myList.pop_front();
+        ans.pop_back();
+        myList.pop_back();
+    }
+    myList.compact();
+    myList.sort();
+    ans.sort();
+    return equal(ans, myList);
+}
+
+bool testIterators() {
+    sjtu::list<int> myList;
+    for (int i = 0; i < 100; ++i)
+        myList.push_back(i);
+    sjtu::list<int>::iterator e = myList.end();
+    myList.compact();
+    if (e != myList.end())
+        return false;
+    --e;
+    if (*e != 99)
+        return false;
+    int i = 0;
+    for (sjtu::list<int>::iterator it = myList.begin(); it != myList.end(); ++it, ++i)
+        if (*it != i)
+            return false;
+    return i == 100;
+}
+
+bool testBint() {
+    std::list<Util::Bint> ans;
+    sjtu::list<Util::Bint> myList;
+    for (int i = 0; i < 1000; ++i) {
+        Util::Bint x = Util::Bint(rand()) * Util::Bint(rand()) * Util::Bint(rand());
+        if (i % 2) {
+            ans.push_back(x);
+            myList.push_back(x);
+        } else {
+            ans.push_front(x);
+            myList.push_front(x);
+        }
+    }
+    myList.compact();
+    return equal(ans, myList);
+}
+
+bool testException() {
+    std::list<Fragile> ans;
+    sjtu::list<Fragile> myList;
+    budget = -1;
+    shuffleOps(ans, myList, 3000);
+    budget = 1500;
+    try {
+        myList.compact();
+    } catch (int) {
+        budget = -1;
+        if (!equal(ans, myList))
+            return false;
+        myList.compact();
+        return equal(ans, myList);
+    }
+    budget = -1;
+    return false;
+}
+
+int main() {
+    srand(2653);
+    bool (*testList[])() = {
+            testCompact, testAfterCompact, testIterators, testBint, testException
+    };
+    const char* Messages[] = {
+            "Test 1: Testing compact()...",
+            "Test 2: Testing modification of a compacted list...",
+            "Test 3: Testing iterators after compact()...",
+            "Test 4: Testing class-bint...",
+            "Test 5: Testing exception safety..."
+    };
+
+    bool okay = true;
+    for (int i = 0; i < sizeof(testList) / sizeof(testList[0]); ++i) {
+        printf("%s", Messages[i]);
+        if (testList[i]()){
+            printf("Passed\n");
+        } else {
+            okay = false;
+            printf("Failed\n");
+        }
+    }
+
+    if (okay)
+        printf("Congratulations, you have passed all tests!\n");
+    else printf("Unfortunately, you failed in some of the tests.\n");
+    return 0;
+}
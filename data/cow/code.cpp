@@ -0,0 +1,251 @@
+#include "class-bint.hpp"
+#include "cow_list.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <vector>
+
+const int N = 2e4;
+
+template<typename T>
+bool equal(const std::list<T> &x, const sjtu::cow_list<T> &y) {
+    if (x.size() != y.size())
+        return false;
+    typename std::list<T>::const_iterator itx = x.cbegin();
+    typename sjtu::cow_list<T>::const_iterator ity = y.cbegin();
+    for (; itx != x.cend() && ity != y.cend(); ++itx, ++ity)
+        if (!(*itx == *ity))
+            return false;
+    return ity == y.cend();
+}
+
+bool testShare() {
+    std::list<int> ans;
+    sjtu::cow_list<int> a;
+    for (int i = 0; i < N; ++i) {
+        ans.push_back(i);
+        a.push_back(i);
+    }
+    sjtu::cow_list<int> b(a), c;
+    c = b;
+    if (!a.shared() || &a.view() != &b.view() || &b.view() != &c.view())
+        return false;
+    b.push_front(-1);
+    if (&a.view() == &b.view() || &a.view() != &c.view() || b.size() != (size_t)N + 1)
+        return false;
+    c.pop_back();
+    if (a.shared() || !equal(ans, a))
+        return false;
+    ans.pop_back();
+    return equal(ans, c) && b.front() == -1;
+}
+
+bool testSnapshots() {
+    std::vector<std::list<int> > ans(1);
+    std::vector<sjtu::cow_list<int> > versions(1);
+    for (int i = 0; i < 3000; ++i) {
+        size_t from = rand() % versions.size();
+        std::list<int> x = ans[from];
+        sjtu::cow_list<int> y = versions[from];
+        int op = rand() % 4, v = rand();
+        if (op == 0) {
+            x.push_back(v);
+            y.push_back(v);
+        } else if (op == 1) {
+            x.push_front(v);
+            y.push_front(v);
+        } else if (op == 2 && !x.empty()) {
+            x.pop_front();
+            y.pop_front();
+        } else if (!x.empty()) {
+            x.pop_back();
+            y.pop_back();
+        }
+        ans.push_back(x);
+        versions.push_back(y);
+    }
+    for (size_t i = 0; i < ans.size(); ++i)
+        if (!equal(ans[i], versions[i]))
+            return false;
+    return true;
+}
+
+bool testIterators() {
+    sjtu::cow_list<int> a;
+    for (int i = 0; i < 10; ++i)
+        a.push_back(i);
+    sjtu::cow_list<int>::iterator it = a.begin();
+    sjtu::cow_list<int> b(a);
+    *it = 100;
+    if (b.front() != 0 || a.front() != 100)
+        return false;
+    sjtu::cow_list<int> c;
+    sjtu::cow_list<int>::iterator in = c.insert(c.end(), 5);
+    sjtu::cow_list<int> d(c);
+    *in = 7;
+    if (d.back() != 5 || c.back() != 7)
+        return false;
+    sjtu::cow_list<int>::iterator er = c.erase(c.begin());
+    sjtu::cow_list<int> e(c);
+    if (er != c.end() || !e.empty())
+        return false;
+    c.clear();
+    c.push_back(1);
+    sjtu::cow_list<int> f(c);
+    return f.shared() && f.back() == 1;
+}
+
+bool testPositional() {
+    std::list<int> ans;
+    sjtu::cow_list<int> a;
+    for (int i = 0; i < 1000; ++i) {
+        ans.push_back(i);
+        a.push_back(i);
+    }
+    std::vector<std::list<int> > ansSnaps;
+    std::vector<sjtu::cow_list<int> > snaps;
+    for (int i = 0; i < 500; ++i) {
+        size_t k = rand() % (ans.size() + 1);
+        std::list<int>::iterator it = ans.begin();
+        for (size_t j = 0; j < k; ++j) ++it;
+        if (it != ans.end() && rand() % 2) {
+            ans.erase(it);
+            a.erase(k);
+        } else {
+            int x = rand();
+            ans.insert(it, x);
+            if (*a.insert(k, x) != x)
+                return false;
+        }
+        // a copy after an edit by index is still O(1)
+        ansSnaps.push_back(ans);
+        snaps.push_back(a);
+        if (!a.shared() || &snaps.back().view() != &a.view())
+            return false;
+    }
+    for (size_t i = 0; i < snaps.size(); ++i)
+        if (!equal(ansSnaps[i], snaps[i]))
+            return false;
+    sjtu::cow_list<int> b;
+    b.insert(0, 1);
+    b.insert(1, 3);
+    b.insert(1, 2);
+    if (b.erase(2) != b.cend() || b.size() != 2 || b.front() != 1 || b.back() != 2)
+        return false;
+    return equal(ans, a);
+}
+
+bool testOperations() {
+    std::list<int> ans, other;
+    sjtu::cow_list<int> a, b;
+    for (int i = 0; i < 5000; ++i) {
+        int x = rand() % 1000;
+        ans.push_back(x);
+        a.push_back(x);
+        x = rand() % 1000;
+        other.push_back(x);
+        b.push_back(x);
+    }
+    std::list<int> ansSnap = ans, otherSnap = other;
+    sjtu::cow_list<int> snap(a), otherCopy(b);
+    ans.sort();
+    a.sort();
+    other.sort();
+    b.sort();
+    ans.merge(other);
+    a.merge(b);
+    if (!equal(ans, a) || !b.empty() || !equal(otherSnap, otherCopy))
+        return false;
+    ans.unique();
+    a.unique();
+    ans.reverse();
+    a.reverse();
+    return equal(ans, a) && equal(ansSnap, snap);
+}
+
+bool testBint() {
+    std::list<Util::Bint> ans;
+    sjtu::cow_list<Util::Bint> a;
+    for (int i = 0; i < 300; ++i) {
+        Util::Bint x = Util::Bint(rand()) * Util::Bint(rand());
+        ans.push_back(x);
+        a.push_back(x);
+    }
+    std::vector<sjtu::cow_list<Util::Bint> > copies(50, a);
+    for (size_t i = 0; i < copies.size(); i += 2)
+        copies[i].pop_front();
+    for (size_t i = 1; i < copies.size(); i += 2)
+        if (!equal(ans, copies[i]))
+            return false;
+    ans.pop_front();
+    return equal(ans, copies[0]);
+}
+
+bool testException() {
+    sjtu::cow_list<int> a;
+    int caught = 0;
+    try {
+        a.pop_back();
+    } catch (sjtu::container_is_empty) {
+        ++caught;
+    }
+    a.push_back(1);
+    sjtu::cow_list<int> b(a);
+    try {
+        b.front();
+        b.pop_front();
+        b.pop_front();
+    } catch (sjtu::container_is_empty) {
+        ++caught;
+    }
+    try {
+        sjtu::cow_list<int> c;
+        c.erase(a.begin());
+    } catch (sjtu::invalid_iterator) {
+        ++caught;
+    }
+    try {
+        b.erase(0);
+    } catch (sjtu::index_out_of_bound) {
+        ++caught;
+    }
+    try {
+        a.insert(2, 5);
+    } catch (sjtu::index_out_of_bound) {
+        ++caught;
+    }
+    return caught == 5 && a.size() == 1 && b.empty();
+}
+
+int main() {
+    srand(2653);
+    bool (*testList[])() = {
+            testShare, testSnapshots, testIterators, testPositional, testOperations, testBint, testException
+    };
+    const char* Messages[] = {
+            "Test 1: Testing sharing and detaching...",
+            "Test 2: Testing snapshots...",
+            "Test 3: Testing writes through mutable iterators...",
+            "Test 4: Testing insert() and erase() by index...",
+            "Test 5: Testing sort(), merge(), unique() and reverse()...",
+            "Test 6: Testing class-bint...",
+            "Test 7: Testing exception throw..."
+    };
+
+    bool okay = true;
+    for (int i = 0; i < sizeof(testList) / sizeof(testList[0]); ++i) {
+        printf("%s", Messages[i]);
+        if (testList[i]()){
+            printf("Passed\n");
+        } else {
+            okay = false;
+            printf("Failed\n");
+        }
+    }
+
+    if (okay)
+        printf("Congratulations, you have passed all tests!\n");
+    else printf("Unfortunately, you failed in some of the tests.\n");
+    return 0;
+}
@@ -0,0 +1,169 @@
+#include "class-bint.hpp"
+#include "list.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <set>
+#include <sstream>
+#include <string>
+
+const int N = 1e5;
+
+template<typename T>
+bool equal(const std::list<T> &x, const sjtu::list<T> &y) {
+    if (x.size() != y.size())
+        return false;
+    typename std::list<T>::const_iterator itx = x.cbegin();
+    typename sjtu::list<T>::const_iterator ity = y.cbegin();
+    for (; itx != x.cend() && ity != y.cend(); ++itx, ++ity)
+        if (!(*itx == *ity))
+            return false;
+    return ity == y.cend();
+}
+
+/**
+ * keep the first occurrence of every value
+ */
+template<typename T>
+std::list<T> firstOccurrences(const std::list<T> &x) {
+    std::set<T> seen;
+    std::list<T> res;
+    for (typename std::list<T>::const_iterator it = x.cbegin(); it != x.cend(); ++it)
+        if (seen.insert(*it).second)
+            res.push_back(*it);
+    return res;
+}
+
+struct Collide {
+    size_t operator()(int x) const { return x % 3; }
+};
+
+struct BintHash {
+    size_t operator()(const Util::Bint &x) const {
+        std::ostringstream os;
+        os << x;
+        return std::hash<std::string>()(os.str());
+    }
+};
+
+bool testDedupe() {
+    const int ranges[] = {1, 10, 1000, N * 10};
+    for (int k = 0; k < 4; ++k) {
+        std::list<int> src;
+        sjtu::list<int> myList;
+        for (int i = 0; i < N; ++i) {
+            int x = rand() % ranges[k];
+            src.push_back(x);
+            myList.push_back(x);
+        }
+        std::list<int> ans = firstOccurrences(src);
+        if (myList.dedupe(std::hash<int>()) != src.size() - ans.size() || !equal(ans, myList))
+            return false;
+        if (myList.dedupe(std::hash<int>()) != 0)
+            return false;
+    }
+    sjtu::list<int> empty;
+    return empty.dedupe(std::hash<int>()) == 0 && empty.empty();
+}
+
+bool testCollisions() {
+    std::list<int> src;
+    sjtu::list<int> myList;
+    for (int i = 0; i < 3000; ++i) {
+        int x = rand() % 500;
+        src.push_back(x);
+        myList.push_back(x);
+    }
+    std::list<int> ans = firstOccurrences(src);
+    return myList.dedupe(Collide()) == src.size() - ans.size() && equal(ans, myList);
+}
+
+bool testStrings() {
+    std::list<std::string> src;
+    sjtu::list<std::string> myList;
+    for (int i = 0; i < 20000; ++i) {
+        std::string s(1 + rand() % 3, 'a' + rand() % 4);
+        src.push_back(s);
+        myList.push_back(s);
+    }
+    std::list<std::string> ans = firstOccurrences(src);
+    return myList.dedupe(std::hash<std::string>()) == src.size() - ans.size() && equal(ans, myList);
+}
+
+bool testBint() {
+    std::list<Util::Bint> src;
+    sjtu::list<Util::Bint> myList;
+    for (int i = 0; i < 3000; ++i) {
+        Util::Bint x = Util::Bint(rand() % 40) * Util::Bint(1000000007);
+        src.push_back(x);
+        myList.push_back(x);
+    }
+    std::list<Util::Bint> ans = firstOccurrences(src);
+    return myList.dedupe(BintHash()) == src.size() - ans.size() && equal(ans, myList);
+}
+
+bool testException() {
+    std::list<int> src;
+    sjtu::list<int> myList;
+    for (int i = 0; i < 1000; ++i) {
+        int x = rand() % 50;
+        src.push_back(x);
+        myList.push_back(x);
+    }
+    int calls = 0;
+    size_t removed = 0;
+    try {
+        myList.dedupe([&calls](int x) -> size_t {
+            if (++calls > 500) throw 1;
+            return x;
+        });
+        return false;
+    } catch (int) {}
+    std::list<int>::iterator a = src.begin();
+    for (sjtu::list<int>::iterator it = myList.begin(); it != myList.end(); ++it, ++a) {
+        while (a != src.end() && *a != *it) {
+            ++a;
+            ++removed;
+        }
+        if (a == src.end())
+            return false;
+    }
+    removed += std::distance(a, src.end());
+    if (removed + myList.size() != src.size() || firstOccurrences(src).size() != 50)
+        return false;
+    myList.dedupe(std::hash<int>());
+    return equal(firstOccurrences(src), myList);
+}
+
+int main() {
+    srand(2653);
+    bool (*testList[])() = {
+            testDedupe, testCollisions, testStrings, testBint, testException
+    };
+    const char* Messages[] = {
+            "Test 1: Testing dedupe()...",
+            "Test 2: Testing a hash with many collisions...",
+            "Test 3: Testing std::string...",
+            "Test 4: Testing class-bint...",
+            "Test 5: Testing exception safety..."
+    };
+
+    bool okay = true;
+    for (int i = 0; i < sizeof(testList) / sizeof(testList[0]); ++i) {
+        printf("%s", Messages[i]);
+        if (testList[i]()){
+            printf("Passed\n");
+        } else {
+            okay = false;
+            printf("Failed\n");
+        }
+    }
+
+    if (okay)
+        printf("Congratulations, you have passed all tests!\n");
+    else printf("Unfortunately, you failed in some of the tests.\n");
+    return 0;
+}
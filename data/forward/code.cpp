@@ -0,0 +1,234 @@
+#include "class-bint.hpp"
+#include "forward_list.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <forward_list>
+#include <vector>
+
+const int N = 5e4;
+
+long long throwAt = -1, comparisons = 0; // Record throws at comparison throwAt, -1 for never
+
+/**
+ * compared by key only, id tells equivalent records apart
+ */
+class Record {
+public:
+    int key, id;
+    Record(int k, int i): key(k), id(i) {}
+    bool operator<(const Record &rhs) const {
+        if (++comparisons == throwAt) throw 1;
+        return key < rhs.key;
+    }
+    bool operator==(const Record &rhs) const { return key == rhs.key && id == rhs.id; }
+};
+
+template<typename T>
+bool equal(const std::forward_list<T> &x, const sjtu::forward_list<T> &y) {
+    size_t n = 0;
+    typename std::forward_list<T>::const_iterator itx = x.cbegin();
+    typename sjtu::forward_list<T>::const_iterator ity = y.cbegin();
+    for (; itx != x.cend() && ity != y.cend(); ++itx, ++ity, ++n)
+        if (!(*itx == *ity))
+            return false;
+    return itx == x.cend() && ity == y.cend() && n == y.size();
+}
+
+bool testInsertErase() {
+    std::forward_list<int> ans;
+    sjtu::forward_list<int> myList;
+    size_t size = 0;
+    for (int i = 0; i < N * 2; ++i) {
+        size_t k = rand() % (size + 1);
+        if (k > 100)
+            k = 100;
+        std::forward_list<int>::iterator a = ans.before_begin();
+        sjtu::forward_list<int>::iterator b = myList.before_begin();
+        for (size_t j = 0; j < k; ++j, ++a, ++b);
+        std::forward_list<int>::iterator na = a;
+        ++na;
+        if (na != ans.end() && rand() % 3 == 0) {
+            std::forward_list<int>::iterator ra = ans.erase_after(a);
+            sjtu::forward_list<int>::iterator rb = myList.erase_after(b);
+            if ((ra == ans.end()) != (rb == myList.end()))
+                return false;
+            --size;
+        } else {
+            int x = rand();
+            if (*ans.insert_after(a, x) != *myList.insert_after(b, x))
+                return false;
+            ++size;
+        }
+        if (rand() % 10 == 0 && size > 0) {
+            ans.pop_front();
+            myList.pop_front();
+            --size;
+        }
+    }
+    return equal(ans, myList) && myList.size() == size && (size == 0 || myList.front() == ans.front());
+}
+
+bool testSort() {
+    for (int pattern = 0; pattern < 3; ++pattern) {
+        std::vector<Record> src;
+        for (int i = 0; i < N; ++i) {
+            int key = pattern == 0 ? rand() % 100 : pattern == 1 ? i / 7 : N - i / 7;
+            src.push_back(Record(key, i));
+        }
+        std::forward_list<Record> ans(src.begin(), src.end());
+        sjtu::forward_list<Record> myList;
+        for (size_t i = src.size(); i-- > 0; )
+            myList.push_front(src[i]);
+        ans.sort();
+        myList.sort();
+        if (!equal(ans, myList))
+            return false;
+    }
+    return true;
+}
+
+bool testMerge() {
+    std::vector<Record> x, y;
+    for (int i = 0; i < N; ++i) {
+        x.push_back(Record(rand() % 1000, i));
+        y.push_back(Record(rand() % 1000, N + i));
+    }
+    std::stable_sort(x.begin(), x.end());
+    std::stable_sort(y.begin(), y.end());
+    std::forward_list<Record> ansX(x.begin(), x.end()), ansY(y.begin(), y.end());
+    sjtu::forward_list<Record> a, b;
+    for (size_t i = x.size(); i-- > 0; ) {
+        a.push_front(x[i]);
+        b.push_front(y[i]);
+    }
+    ansX.merge(ansY);
+    a.merge(b);
+    if (!equal(ansX, a) || !b.empty() || b.size() != 0 || a.size() != (size_t)N * 2)
+        return false;
+    a.merge(a);
+    return equal(ansX, a);
+}
+
+bool testSplice() {
+    std::forward_list<int> ansA, ansB;
+    sjtu::forward_list<int> a, b;
+    for (int i = 0; i < 100; ++i) {
+        ansA.push_front(i);
+        a.push_front(i);
+        ansB.push_front(-i);
+        b.push_front(-i);
+    }
+    std::forward_list<int>::iterator pa = ansA.begin();
+    sjtu::forward_list<int>::iterator pb = a.begin();
+    for (int i = 0; i < 10; ++i, ++pa, ++pb);
+    ansA.splice_after(pa, ansB, ansB.begin());
+    a.splice_after(pb, b, b.begin());
+    ansA.splice_after(ansA.before_begin(), ansA, pa);
+    a.splice_after(a.before_begin(), a, pb);
+    if (!equal(ansA, a) || !equal(ansB, b) || a.size() != 101 || b.size() != 99)
+        return false;
+    ansA.splice_after(pa, ansB);
+    a.splice_after(pb, b);
+    if (!equal(ansA, a) || !b.empty() || a.size() != 200)
+        return false;
+    ansA.reverse();
+    a.reverse();
+    return equal(ansA, a);
+}
+
+bool testBint() {
+    std::forward_list<Util::Bint> ans;
+    sjtu::forward_list<Util::Bint> myList;
+    for (int i = 0; i < 2000; ++i) {
+        Util::Bint x = Util::Bint(rand()) * Util::Bint(rand() % 1000);
+        ans.push_front(x);
+        myList.push_front(x);
+    }
+    ans.sort();
+    myList.sort();
+    if (!equal(ans, myList))
+        return false;
+    sjtu::forward_list<Util::Bint> other(myList);
+    myList.clear();
+    return equal(ans, other) && myList.empty();
+}
+
+bool testException() {
+    std::vector<Record> src;
+    sjtu::forward_list<Record> myList;
+    for (int i = 0; i < 10000; ++i) {
+        src.push_back(Record(rand(), i));
+        myList.push_front(src.back());
+    }
+    comparisons = 0;
+    throwAt = 60000;
+    try {
+        myList.sort();
+        throwAt = -1;
+        return false;
+    } catch (int) {}
+    throwAt = -1;
+    std::vector<Record> left;
+    for (sjtu::forward_list<Record>::iterator it = myList.begin(); it != myList.end(); ++it)
+        left.push_back(*it);
+    struct ById {
+        bool operator()(const Record &a, const Record &b) const { return a.id < b.id; }
+    };
+    std::sort(left.begin(), left.end(), ById());
+    if (left.size() != src.size() || myList.size() != src.size())
+        return false;
+    for (size_t i = 0; i < left.size(); ++i)
+        if (!(left[i] == src[i]))
+            return false;
+    int caught = 0;
+    sjtu::forward_list<int> empty;
+    try {
+        empty.pop_front();
+    } catch (sjtu::container_is_empty) {
+        ++caught;
+    }
+    try {
+        empty.erase_after(empty.before_begin());
+    } catch (...) {
+        ++caught;
+    }
+    try {
+        *empty.before_begin();
+    } catch (sjtu::invalid_iterator) {
+        ++caught;
+    }
+    return caught == 3;
+}
+
+int main() {
+    srand(2653);
+    bool (*testList[])() = {
+            testInsertErase, testSort, testMerge, testSplice, testBint, testException
+    };
+    const char* Messages[] = {
+            "Test 1: Testing insert_after() & erase_after()...",
+            "Test 2: Testing stability of sort()...",
+            "Test 3: Testing merge()...",
+            "Test 4: Testing splice_after() & reverse()...",
+            "Test 5: Testing class-bint...",
+            "Test 6: Testing exception safety..."
+    };
+
+    bool okay = true;
+    for (int i = 0; i < sizeof(testList) / sizeof(testList[0]); ++i) {
+        printf("%s", Messages[i]);
+        if (testList[i]()){
+            printf("Passed\n");
+        } else {
+            okay = false;
+            printf("Failed\n");
+        }
+    }
+
+    if (okay)
+        printf("Congratulations, you have passed all tests!\n");
+    else printf("Unfortunately, you failed in some of the tests.\n");
+    return 0;
+}
@@ -0,0 +1,183 @@
+#include "class-bint.hpp"
+#include "index_list.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <vector>
+
+const int N = 3e4;
+
+typedef sjtu::index_list<int, true> list_t;
+
+template<typename T>
+bool equal(const std::list<T> &x, const sjtu::index_list<T, true> &y) {
+    if (x.size() != y.size())
+        return false;
+    typename std::list<T>::const_iterator itx = x.cbegin();
+    typename sjtu::index_list<T, true>::const_iterator ity = y.cbegin();
+    for (; itx != x.cend() && ity != y.cend(); ++itx, ++ity)
+        if (!(*itx == *ity))
+            return false;
+    return ity == y.cend();
+}
+
+struct Entry {
+    list_t::handle h;
+    int value;
+    bool alive;
+};
+
+bool testHandles() {
+    list_t myList;
+    std::vector<Entry> entries;
+    std::vector<size_t> live;
+    for (int i = 0; i < N; ++i) {
+        if (live.empty() || rand() % 3) {
+            list_t::iterator it = rand() % 2 ? myList.end() : myList.begin();
+            Entry e = {myList.handle_of(myList.insert(it, i)), i, true};
+            live.push_back(entries.size());
+            entries.push_back(e);
+        } else {
+            size_t k = rand() % live.size();
+            Entry &e = entries[live[k]];
+            list_t::iterator it = myList.find(e.h);
+            if (it == myList.end() || *it != e.value)
+                return false;
+            myList.erase(it);
+            e.alive = false;
+            live[k] = live.back();
+            live.pop_back();
+        }
+    }
+    for (size_t i = 0; i < entries.size(); ++i) {
+        if (myList.valid(entries[i].h) != entries[i].alive)
+            return false;
+        if (entries[i].alive && myList.at(entries[i].h) != entries[i].value)
+            return false;
+        if (!entries[i].alive && myList.find(entries[i].h) != myList.end())
+            return false;
+    }
+    return myList.size() == live.size();
+}
+
+bool testReuse() {
+    list_t myList;
+    myList.push_back(1);
+    list_t::handle old = myList.handle_of(myList.begin());
+    myList.pop_back();
+    myList.push_back(2);
+    list_t::handle fresh = myList.handle_of(myList.begin());
+    if (myList.valid(old) || !myList.valid(fresh) || old == fresh || myList.at(fresh) != 2)
+        return false;
+    list_t::handle none;
+    return !myList.valid(none) && myList.find(none) == myList.end() && sizeof(list_t::handle) == 8;
+}
+
+bool testGrowthAndClear() {
+    std::list<int> ans;
+    list_t myList;
+    std::vector<list_t::handle> hs;
+    for (int i = 0; i < N; ++i) {
+        myList.push_back(i);
+        ans.push_back(i);
+        hs.push_back(myList.handle_of(--myList.end()));
+    }
+    for (int i = 0; i < N; ++i)
+        if (!myList.valid(hs[i]) || myList.at(hs[i]) != i)
+            return false;
+    for (int i = 0; i < N; i += 2)
+        myList.at(hs[i]) = -i;
+    for (std::list<int>::iterator it = ans.begin(); it != ans.end(); ++it)
+        if (*it % 2 == 0)
+            *it = -*it;
+    if (!equal(ans, myList))
+        return false;
+    myList.clear();
+    for (int i = 0; i < N; ++i)
+        if (myList.valid(hs[i]))
+            return false;
+    for (int i = 0; i < 100; ++i)
+        myList.push_back(i);
+    for (int i = 0; i < N; ++i)
+        if (myList.valid(hs[i]))
+            return false;
+    return myList.size() == 100;
+}
+
+bool testBint() {
+    sjtu::index_list<Util::Bint, true> myList;
+    std::vector<sjtu::index_list<Util::Bint, true>::handle> hs;
+    std::list<Util::Bint> ans;
+    for (int i = 0; i < 1000; ++i) {
+        Util::Bint x = Util::Bint(rand()) * Util::Bint(rand());
+        ans.push_back(x);
+        myList.push_back(x);
+        hs.push_back(myList.handle_of(--myList.end()));
+    }
+    std::list<Util::Bint>::iterator a = ans.begin();
+    for (int i = 0; i < 1000; ++i, ++a)
+        if (!(myList.at(hs[i]) == *a))
+            return false;
+    for (int i = 0; i < 500; ++i)
+        myList.erase(myList.find(hs[i * 2]));
+    for (int i = 0; i < 1000; ++i)
+        if (myList.valid(hs[i]) != (i % 2 == 1))
+            return false;
+    return myList.size() == 500;
+}
+
+bool testException() {
+    list_t myList, other;
+    myList.push_back(1);
+    other.push_back(2);
+    list_t::handle h = myList.handle_of(myList.begin());
+    myList.pop_front();
+    int caught = 0;
+    try {
+        myList.at(h);
+    } catch (sjtu::invalid_iterator) {
+        ++caught;
+    }
+    try {
+        myList.handle_of(myList.end());
+    } catch (sjtu::invalid_iterator) {
+        ++caught;
+    }
+    try {
+        myList.handle_of(other.begin());
+    } catch (sjtu::invalid_iterator) {
+        ++caught;
+    }
+    return caught == 3 && other.at(other.handle_of(other.begin())) == 2;
+}
+
+int main() {
+    srand(2653);
+    bool (*testList[])() = {
+            testHandles, testReuse, testGrowthAndClear, testBint, testException
+    };
+    const char* Messages[] = {
+            "Test 1: Testing handles under random insert / erase...",
+            "Test 2: Testing reuse of a slot...",
+            "Test 3: Testing handles across growth and clear()...",
+            "Test 4: Testing class-bint...",
+            "Test 5: Testing exception throw..."
+    };
+
+    bool okay = true;
+    for (int i = 0; i < sizeof(testList) / sizeof(testList[0]); ++i) {
+        printf("%s", Messages[i]);
+        if (testList[i]()){
+            printf("Passed\n");
+        } else {
+            okay = false;
+            printf("Failed\n");
+        }
+    }
+
+    if (okay)
+        printf("Congratulations, you have passed all tests!\n");
+    else printf("Unfortunately, you failed in some of the tests.\n");
+    return 0;
+}
@@ -0,0 +1,203 @@
+#include "class-bint.hpp"
+#include "class-matrix.hpp"
+#include "index_list.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+
+const int N = 5e4;
+
+template<typename T>
+bool equal(const std::list<T> &x, const sjtu::index_list<T> &y) {
+    if (x.size() != y.size())
+        return false;
+    typename std::list<T>::const_iterator itx = x.cbegin();
+    typename sjtu::index_list<T>::const_iterator ity = y.cbegin();
+    for (; itx != x.cend() && ity != y.cend(); ++itx, ++ity)
+        if (!(*itx == *ity))
+            return false;
+    return ity == y.cend();
+}
+
+template<typename T>
+void randomOps(std::list<T> &ans, sjtu::index_list<T> &myList, int ops) {
+    for (int i = 0; i < ops; ++i) {
+        int op = rand() % 6;
+        T x = T(rand());
+        if (op == 0 || op == 1) {
+            ans.push_back(x);
+            myList.push_back(x);
+        } else if (op == 2) {
+            ans.push_front(x);
+            myList.push_front(x);
+        } else if (op == 3 && !ans.empty()) {
+            ans.pop_back();
+            myList.pop_back();
+        } else if (op == 4 && !ans.empty()) {
+            ans.pop_front();
+            myList.pop_front();
+        } else if (op == 5) {
+            size_t k = rand() % (ans.size() + 1);
+            typename std::list<T>::iterator a = ans.begin();
+            typename sjtu::index_list<T>::iterator b = myList.begin();
+            for (size_t j = 0; j < k && j < 100; ++j, ++a, ++b);
+            if (a != ans.end() && rand() % 2) {
+                ans.erase(a);
+                myList.erase(b);
+            } else {
+                ans.insert(a, x);
+                myList.insert(b, x);
+            }
+        }
+    }
+}
+
+bool testRandomOps() {
+    std::list<int> ans;
+    sjtu::index_list<int> myList;
+    randomOps(ans, myList, N * 4);
+    return equal(ans, myList) && (ans.empty() || (myList.front() == ans.front() && myList.back() == ans.back()));
+}
+
+bool testCopy() {
+    std::list<int> ans;
+    sjtu::index_list<int> myList;
+    randomOps(ans, myList, N);
+    sjtu::index_list<int> other(myList);
+    if (!equal(ans, other) || other.capacity() < other.size())
+        return false;
+    sjtu::index_list<int> third;
+    third.push_back(1);
+    third = other;
+    third = third;
+    other.clear();
+    return equal(ans, third) && equal(ans, myList) && other.empty();
+}
+
+bool testGrowth() {
+    sjtu::index_list<int> myList;
+    myList.push_back(1);
+    myList.push_back(2);
+    sjtu::index_list<int>::iterator first = myList.begin();
+    sjtu::index_list<int>::iterator last = --myList.end();
+    for (int i = 0; i < N; ++i)
+        myList.insert(last, i + 10);
+    if (*first != 1 || *last != 2 || myList.size() != (size_t)N + 2 || myList.capacity() < (size_t)N + 2)
+        return false;
+    ++first;
+    return *first == 10 && *--last == N + 9;
+}
+
+bool testReuse() {
+    sjtu::index_list<int> myList;
+    myList.reserve(1000);
+    size_t cap = myList.capacity();
+    if (cap < 1000)
+        return false;
+    for (int round = 0; round < 10; ++round) {
+        for (int i = 0; i < 1000; ++i)
+            myList.push_back(i);
+        for (int i = 0; i < 500; ++i) {
+            myList.pop_front();
+            myList.pop_back();
+        }
+    }
+    if (myList.capacity() != cap || !myList.empty())
+        return false;
+    try {
+        myList.reserve(1ULL << 33);
+        return false;
+    } catch (sjtu::runtime_error) {}
+    return myList.capacity() == cap;
+}
+
+bool testClasses() {
+    std::list<Util::Bint> ans;
+    sjtu::index_list<Util::Bint> myList;
+    for (int i = 0; i < 1000; ++i) {
+        Util::Bint x = Util::Bint(rand()) * Util::Bint(rand());
+        ans.push_back(x);
+        myList.push_back(x);
+    }
+    for (int i = 0; i < 300; ++i) {
+        ans.pop_front();
+        myList.pop_front();
+    }
+    if (!equal(ans, myList))
+        return false;
+    std::list<Diamond::Matrix<double> > ansMat;
+    sjtu::index_list<Diamond::Matrix<double> > matList;
+    for (int i = 0; i < 200; ++i) {
+        Diamond::Matrix<double> m(3, 3, rand() % 10);
+        ansMat.push_front(m);
+        matList.push_front(m);
+    }
+    return equal(ansMat, matList);
+}
+
+bool testException() {
+    sjtu::index_list<int> myList, other;
+    int caught = 0;
+    try {
+        myList.pop_back();
+    } catch (sjtu::container_is_empty) {
+        ++caught;
+    }
+    try {
+        myList.back();
+    } catch (sjtu::container_is_empty) {
+        ++caught;
+    }
+    myList.push_back(1);
+    other.push_back(2);
+    try {
+        myList.erase(other.begin());
+    } catch (sjtu::invalid_iterator) {
+        ++caught;
+    }
+    try {
+        myList.erase(myList.end());
+    } catch (sjtu::invalid_iterator) {
+        ++caught;
+    }
+    sjtu::index_list<int>::iterator it = myList.begin();
+    myList.erase(it);
+    try {
+        *it;
+    } catch (sjtu::invalid_iterator) {
+        ++caught;
+    }
+    return caught == 5 && myList.empty() && other.size() == 1;
+}
+
+int main() {
+    srand(2653);
+    bool (*testList[])() = {
+            testRandomOps, testCopy, testGrowth, testReuse, testClasses, testException
+    };
+    const char* Messages[] = {
+            "Test 1: Testing random push / pop / insert / erase...",
+            "Test 2: Testing copy constructor and operator=...",
+            "Test 3: Testing iterators while the arrays grow...",
+            "Test 4: Testing reserve() and reuse of erased slots...",
+            "Test 5: Testing class-bint & class-Matrix...",
+            "Test 6: Testing exception throw..."
+    };
+
+    bool okay = true;
+    for (int i = 0; i < sizeof(testList) / sizeof(testList[0]); ++i) {
+        printf("%s", Messages[i]);
+        if (testList[i]()){
+            printf("Passed\n");
+        } else {
+            okay = false;
+            printf("Failed\n");
+        }
+    }
+
+    if (okay)
+        printf("Congratulations, you have passed all tests!\n");
+    else printf("Unfortunately, you failed in some of the tests.\n");
+    return 0;
+}
@@ -0,0 +1,218 @@
+#include "mapped_list.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+const int N = 3e4;
+const char *Path = "/tmp/sjtu_mapped_list_test.bin";
+
+struct Point {
+    int x, y;
+    bool operator==(const Point &rhs) const { return x == rhs.x && y == rhs.y; }
+};
+
+template<typename T>
+bool equal(const std::list<T> &x, const sjtu::mapped_list<T> &y) {
+    if (x.size() != y.size())
+        return false;
+    typename std::list<T>::const_iterator itx = x.cbegin();
+    typename sjtu::mapped_list<T>::const_iterator ity = y.cbegin();
+    for (; itx != x.cend() && ity != y.cend(); ++itx, ++ity)
+        if (!(*itx == *ity))
+            return false;
+    return ity == y.cend();
+}
+
+long long fileSize() {
+    struct stat st;
+    if (stat(Path, &st) != 0)
+        return -1;
+    return st.st_size;
+}
+
+template<typename T>
+void randomOps(std::list<T> &ans, sjtu::mapped_list<T> &myList, int ops) {
+    for (int i = 0; i < ops; ++i) {
+        int op = rand() % 6;
+        T x = T(rand());
+        if (op == 0 || op == 1) {
+            ans.push_back(x);
+            myList.push_back(x);
+        } else if (op == 2) {
+            ans.push_front(x);
+            myList.push_front(x);
+        } else if (op == 3 && !ans.empty()) {
+            ans.pop_back();
+            myList.pop_back();
+        } else if (op == 4 && !ans.empty()) {
+            ans.pop_front();
+            myList.pop_front();
+        } else if (op == 5) {
+            size_t k = rand() % (ans.size() + 1);
+            typename std::list<T>::iterator a = ans.begin();
+            typename sjtu::mapped_list<T>::iterator b = myList.begin();
+            for (size_t j = 0; j < k && j < 100; ++j, ++a, ++b);
+            if (a != ans.end() && rand() % 2) {
+                ans.erase(a);
+                myList.erase(b);
+            } else {
+                ans.insert(a, x);
+                myList.insert(b, x);
+            }
+        }
+    }
+}
+
+bool testRandomOps() {
+    unlink(Path);
+    std::list<int> ans;
+    sjtu::mapped_list<int> myList(Path);
+    randomOps(ans, myList, N);
+    if (!equal(ans, myList))
+        return false;
+    myList.reverse();
+    ans.reverse();
+    return equal(ans, myList) && myList.front() == ans.front() && myList.back() == ans.back();
+}
+
+bool testReopen() {
+    unlink(Path);
+    std::list<int> ans;
+    {
+        sjtu::mapped_list<int> myList(Path);
+        randomOps(ans, myList, N);
+        myList.sync();
+    }
+    {
+        sjtu::mapped_list<int> myList(Path);
+        if (!equal(ans, myList))
+            return false;
+        randomOps(ans, myList, N);
+    }
+    sjtu::mapped_list<int> myList(Path);
+    return equal(ans, myList);
+}
+
+bool testReuse() {
+    unlink(Path);
+    sjtu::mapped_list<Point> myList(Path);
+    for (int i = 0; i < N; ++i) {
+        Point p = {i, -i};
+        myList.push_back(p);
+    }
+    long long size = fileSize();
+    myList.clear();
+    for (int i = 0; i < N; ++i) {
+        Point p = {-i, i};
+        myList.push_front(p);
+    }
+    if (fileSize() != size || myList.size() != (size_t)N)
+        return false;
+    int i = N - 1;
+    for (sjtu::mapped_list<Point>::iterator it = myList.begin(); it != myList.end(); ++it, --i)
+        if (it->x != -i || it->y != i)
+            return false;
+    return i == -1;
+}
+
+bool testIterators() {
+    unlink(Path);
+    sjtu::mapped_list<int> myList(Path);
+    myList.push_back(1);
+    myList.push_back(2);
+    sjtu::mapped_list<int>::iterator first = myList.begin();
+    sjtu::mapped_list<int>::iterator last = --myList.end();
+    for (int i = 0; i < N; ++i)
+        myList.insert(last, i + 10);
+    if (*first != 1 || *last != 2 || myList.size() != (size_t)N + 2)
+        return false;
+    ++first;
+    return *first == 10 && *--last == N + 9;
+}
+
+bool testReject() {
+    unlink(Path);
+    {
+        sjtu::mapped_list<int> myList(Path);
+        for (int i = 0; i < 100; ++i)
+            myList.push_back(i);
+    }
+    try {
+        sjtu::mapped_list<long long> other(Path);
+        return false;
+    } catch (sjtu::runtime_error) {}
+    if (truncate(Path, fileSize() + 4096) != 0)
+        return false;
+    sjtu::mapped_list<int> myList(Path);
+    for (int i = 100; i < 2000; ++i)
+        myList.push_back(i);
+    int i = 0;
+    for (sjtu::mapped_list<int>::iterator it = myList.begin(); it != myList.end(); ++it, ++i)
+        if (*it != i)
+            return false;
+    return i == 2000;
+}
+
+bool testException() {
+    unlink(Path);
+    sjtu::mapped_list<int> myList(Path);
+    int caught = 0;
+    try {
+        myList.pop_back();
+    } catch (sjtu::container_is_empty) {
+        ++caught;
+    }
+    try {
+        myList.front();
+    } catch (sjtu::container_is_empty) {
+        ++caught;
+    }
+    try {
+        myList.erase(myList.end());
+    } catch (...) {
+        ++caught;
+    }
+    myList.push_back(1);
+    try {
+        ++myList.end();
+    } catch (sjtu::invalid_iterator) {
+        ++caught;
+    }
+    return caught == 4 && myList.size() == 1;
+}
+
+int main() {
+    srand(2653);
+    bool (*testList[])() = {
+            testRandomOps, testReopen, testReuse, testIterators, testReject, testException
+    };
+    const char* Messages[] = {
+            "Test 1: Testing random push / pop / insert / erase...",
+            "Test 2: Testing reopening the file...",
+            "Test 3: Testing reuse of erased nodes...",
+            "Test 4: Testing iterators while the file grows...",
+            "Test 5: Testing files of another element size or length...",
+            "Test 6: Testing exception throw..."
+    };
+
+    bool okay = true;
+    for (int i = 0; i < sizeof(testList) / sizeof(testList[0]); ++i) {
+        printf("%s", Messages[i]);
+        if (testList[i]()){
+            printf("Passed\n");
+        } else {
+            okay = false;
+            printf("Failed\n");
+        }
+    }
+    unlink(Path);
+
+    if (okay)
+        printf("Congratulations, you have passed all tests!\n");
+    else printf("Unfortunately, you failed in some of the tests.\n");
+    return 0;
+}
@@ -0,0 +1,206 @@
+#include "class-bint.hpp"
+#include "small_list.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <vector>
+
+const int N = 1e5;
+
+long long comparisons = 0;
+long long throwAt = -1; // comparison count at which Record throws, -1 for never
+
+/**
+ * compared by key only, id tells equivalent records apart
+ */
+class Record {
+public:
+    int key, id;
+    Record(int k, int i): key(k), id(i) {}
+    Record(const Record &other): key(other.key), id(other.id) {}
+    bool operator<(const Record &rhs) const {
+        if (++comparisons == throwAt) throw 1;
+        return key < rhs.key;
+    }
+    bool operator==(const Record &rhs) const { return key == rhs.key && id == rhs.id; }
+};
+
+template<typename T>
+bool equal(const std::vector<T> &x, const sjtu::list<T> &y) {
+    if (x.size() != y.size())
+        return false;
+    typename sjtu::list<T>::const_iterator ity = y.cbegin();
+    for (size_t i = 0; i < x.size(); ++i, ++ity)
+        if (!(x[i] == *ity))
+            return false;
+    return ity == y.cend();
+}
+
+/**
+ * sorted records with keys drawn by pattern; ids start at base
+ */
+void build(int pattern, int n, int base, std::vector<Record> &ans, sjtu::list<Record> &myList) {
+    std::vector<int> keys;
+    for (int i = 0; i < n; ++i) {
+        if (pattern == 0) keys.push_back(rand() % (4 * N));
+        else if (pattern == 1) keys.push_back(rand() % 10);
+        else if (pattern == 2) keys.push_back(i / 1000 * 2000 + base / N * 1000 + i % 1000);
+        else keys.push_back(base + i);
+    }
+    std::sort(keys.begin(), keys.end());
+    for (int i = 0; i < n; ++i) {
+        ans.push_back(Record(keys[i], base + i));
+        myList.push_back(Record(keys[i], base + i));
+    }
+}
+
+bool testMerge() {
+    for (int pattern = 0; pattern < 4; ++pattern) {
+        std::vector<Record> x, y, ans;
+        sjtu::list<Record> a, b;
+        build(pattern, N, 0, x, a);
+        build(pattern, N / 2 + pattern, N, y, b);
+        std::merge(x.begin(), x.end(), y.begin(), y.end(), std::back_inserter(ans));
+        a.merge(b);
+        if (!equal(ans, a) || !b.empty() || b.size() != 0)
+            return false;
+        b.push_back(Record(0, -1));
+        if (b.size() != 1 || a.size() != ans.size())
+            return false;
+    }
+    return true;
+}
+
+bool testGallop() {
+    std::vector<Record> x, y, ans;
+    sjtu::list<Record> a, b;
+    build(3, N, 0, x, a);
+    build(3, N, N, y, b);
+    std::merge(x.begin(), x.end(), y.begin(), y.end(), std::back_inserter(ans));
+    comparisons = 0;
+    a.merge(b);
+    if (comparisons > 100 || !equal(ans, a))
+        return false;
+    std::vector<Record> z, ans2;
+    sjtu::list<Record> c;
+    build(3, N, -N, z, c);
+    std::merge(ans.begin(), ans.end(), z.begin(), z.end(), std::back_inserter(ans2));
+    comparisons = 0;
+    a.merge(c);
+    return comparisons <= 100 && equal(ans2, a) && c.empty();
+}
+
+bool testEmpty() {
+    std::vector<Record> x, none;
+    sjtu::list<Record> a, b;
+    build(0, 100, 0, x, a);
+    a.merge(b);
+    if (!equal(x, a))
+        return false;
+    b.merge(a);
+    if (!equal(x, b) || !a.empty())
+        return false;
+    b.merge(b);
+    a.merge(a);
+    return equal(x, b) && equal(none, a);
+}
+
+bool testSmallList() {
+    std::vector<Record> x, y, ans;
+    sjtu::list<Record> a;
+    sjtu::small_list<Record, 8> b;
+    build(1, 1000, 0, x, a);
+    build(1, 6, 1000, y, b);
+    std::merge(x.begin(), x.end(), y.begin(), y.end(), std::back_inserter(ans));
+    a.merge(b);
+    if (!equal(ans, a) || !b.empty() || b.inline_available() != 8)
+        return false;
+    b.push_back(Record(1, 1));
+    return b.size() == 1;
+}
+
+bool testBint() {
+    std::vector<Util::Bint> x, y, ans;
+    sjtu::list<Util::Bint> a, b;
+    for (int i = 0; i < 2000; ++i) {
+        x.push_back(Util::Bint(rand()) * Util::Bint(rand() % 100));
+        y.push_back(Util::Bint(rand()) * Util::Bint(rand() % 100));
+    }
+    std::sort(x.begin(), x.end());
+    std::sort(y.begin(), y.end());
+    for (int i = 0; i < 2000; ++i) {
+        a.push_back(x[i]);
+        b.push_back(y[i]);
+    }
+    std::merge(x.begin(), x.end(), y.begin(), y.end(), std::back_inserter(ans));
+    a.merge(b);
+    return equal(ans, a);
+}
+
+template<typename T>
+size_t walk(const sjtu::list<T> &l) {
+    size_t n = 0;
+    for (typename sjtu::list<T>::const_iterator it = l.cbegin(); it != l.cend(); ++it) ++n;
+    return n;
+}
+
+bool testException() {
+    const long long at[] = {1, 50, 150};
+    for (int k = 0; k < 6; ++k) {
+        std::vector<Record> x, y;
+        sjtu::list<Record> a, b;
+        build(k % 2, 200, 0, x, a);
+        build(k % 2, 200, N, y, b);
+        comparisons = 0;
+        throwAt = at[k / 2];
+        try {
+            a.merge(b);
+            throwAt = -1;
+            return false;
+        } catch (int) {
+            throwAt = -1;
+        }
+        if (a.size() != walk(a) || b.size() != walk(b) || a.size() + b.size() != 400)
+            return false;
+        // nothing lost: a is still sorted, and merging the rest gives the full merge
+        std::vector<Record> ans;
+        std::merge(x.begin(), x.end(), y.begin(), y.end(), std::back_inserter(ans));
+        a.merge(b);
+        if (!equal(ans, a) || !b.empty() || walk(b) != 0)
+            return false;
+    }
+    return true;
+}
+
+int main() {
+    srand(2653);
+    bool (*testList[])() = {
+            testMerge, testGallop, testEmpty, testSmallList, testBint, testException
+    };
+    const char* Messages[] = {
+            "Test 1: Testing stability of merge()...",
+            "Test 2: Testing merge() of disjoint runs...",
+            "Test 3: Testing empty lists and self merge...",
+            "Test 4: Testing merge() of a small_list...",
+            "Test 5: Testing class-bint...",
+            "Test 6: Testing exception safety..."
+    };
+
+    bool okay = true;
+    for (int i = 0; i < sizeof(testList) / sizeof(testList[0]); ++i) {
+        printf("%s", Messages[i]);
+        if (testList[i]()){
+            printf("Passed\n");
+        } else {
+            okay = false;
+            printf("Failed\n");
+        }
+    }
+
+    if (okay)
+        printf("Congratulations, you have passed all tests!\n");
+    else printf("Unfortunately, you failed in some of the tests.\n");
+    return 0;
+}
@@ -0,0 +1,210 @@
+#include "class-bint.hpp"
+#include "small_list.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+const int N = 5e4;
+
+long long comparisons = 0;
+long long throwAt = -1; // comparison count at which Record throws, -1 for never
+
+/**
+ * compared by key only, id tells equivalent records apart
+ */
+class Record {
+public:
+    int key, id;
+    Record(int k, int i): key(k), id(i) {}
+    Record(const Record &other): key(other.key), id(other.id) {}
+    bool operator<(const Record &rhs) const {
+        if (++comparisons == throwAt) throw 1;
+        return key < rhs.key;
+    }
+    bool operator==(const Record &rhs) const { return key == rhs.key && id == rhs.id; }
+};
+
+template<typename T>
+bool equal(const std::vector<T> &x, const sjtu::list<T> &y) {
+    if (x.size() != y.size())
+        return false;
+    typename sjtu::list<T>::const_iterator ity = y.cbegin();
+    for (size_t i = 0; i < x.size(); ++i, ++ity)
+        if (!(x[i] == *ity))
+            return false;
+    return ity == y.cend();
+}
+
+int nextId = 0;
+
+/**
+ * append n sorted records with keys below range to myList, and the same records to all
+ */
+void build(int n, int range, std::vector<Record> &all, sjtu::list<Record> &myList) {
+    std::vector<int> keys;
+    for (int i = 0; i < n; ++i)
+        keys.push_back(rand() % range);
+    std::sort(keys.begin(), keys.end());
+    for (int i = 0; i < n; ++i) {
+        all.push_back(Record(keys[i], nextId));
+        myList.push_back(Record(keys[i], nextId++));
+    }
+}
+
+bool testMergeAll() {
+    const int ks[] = {1, 2, 5, 16, 100};
+    for (int t = 0; t < 5; ++t) {
+        std::vector<Record> all;
+        sjtu::list<Record> target;
+        std::vector<sjtu::list<Record> > lists(ks[t]);
+        build(rand() % 1000, 5000, all, target);
+        for (int i = 0; i < ks[t]; ++i)
+            build(rand() % (N / ks[t]), 5000, all, lists[i]);
+        std::stable_sort(all.begin(), all.end());
+        target.merge_all(lists.begin(), lists.end());
+        if (!equal(all, target))
+            return false;
+        for (int i = 0; i < ks[t]; ++i)
+            if (!lists[i].empty())
+                return false;
+    }
+    return true;
+}
+
+bool testPointers() {
+    std::vector<Record> all;
+    sjtu::list<Record> target, a, b, c;
+    sjtu::small_list<Record, 4> s;
+    build(100, 50, all, target);
+    build(3000, 50, all, a);
+    build(3, 50, all, s);
+    build(2000, 50, all, b);
+    std::vector<sjtu::list<Record> *> ptrs;
+    ptrs.push_back(&a);
+    ptrs.push_back(&target);
+    ptrs.push_back(&s);
+    ptrs.push_back(&c);
+    ptrs.push_back(&a);
+    ptrs.push_back(&b);
+    ptrs.push_back(&s);
+    std::stable_sort(all.begin(), all.end());
+    target.merge_all(ptrs.begin(), ptrs.end());
+    if (!equal(all, target) || !a.empty() || !b.empty() || !s.empty() || s.inline_available() != 4)
+        return false;
+    s.push_back(Record(0, 0));
+    return s.size() == 1;
+}
+
+bool testEmpty() {
+    std::vector<Record> all, none;
+    sjtu::list<Record> target;
+    std::vector<sjtu::list<Record> > lists(3);
+    target.merge_all(lists.begin(), lists.end());
+    if (!target.empty())
+        return false;
+    target.merge_all(lists.begin(), lists.begin());
+    build(10, 5, all, lists[1]);
+    target.merge_all(lists.begin(), lists.end());
+    if (!equal(all, target) || !equal(none, lists[1]))
+        return false;
+    lists[2].merge_all(&target, &target + 1);
+    return equal(all, lists[2]) && target.empty();
+}
+
+bool testBint() {
+    std::vector<Util::Bint> all;
+    sjtu::list<Util::Bint> target;
+    std::vector<sjtu::list<Util::Bint> > lists(8);
+    for (int i = 0; i < 8; ++i) {
+        std::vector<Util::Bint> part;
+        for (int j = 0; j < 200; ++j)
+            part.push_back(Util::Bint(rand()) * Util::Bint(rand() % 10));
+        std::sort(part.begin(), part.end());
+        for (int j = 0; j < 200; ++j) {
+            all.push_back(part[j]);
+            lists[i].push_back(part[j]);
+        }
+    }
+    std::stable_sort(all.begin(), all.end());
+    target.merge_all(lists.begin(), lists.end());
+    return equal(all, target);
+}
+
+template<typename T>
+size_t walk(const sjtu::list<T> &l) {
+    size_t n = 0;
+    for (typename sjtu::list<T>::const_iterator it = l.cbegin(); it != l.cend(); ++it) ++n;
+    return n;
+}
+
+bool testException() {
+    const long long at[] = {1, 5, 50, 2000};
+    for (int t = 0; t < 4; ++t) {
+        std::vector<Record> all;
+        sjtu::list<Record> target;
+        std::vector<sjtu::list<Record> > lists(6);
+        build(300, 100, all, target);
+        for (int i = 0; i < 6; ++i)
+            build(300, 100, all, lists[i]);
+        comparisons = 0;
+        throwAt = at[t];
+        try {
+            target.merge_all(lists.begin(), lists.end());
+            throwAt = -1;
+            return false;
+        } catch (int) {
+            throwAt = -1;
+        }
+        size_t total = target.size();
+        if (target.size() != walk(target))
+            return false;
+        for (int i = 0; i < 6; ++i) {
+            if (lists[i].size() != walk(lists[i]))
+                return false;
+            total += lists[i].size();
+        }
+        if (total != all.size())
+            return false;
+        // every list is still sorted, so merging again gives the full result
+        std::stable_sort(all.begin(), all.end());
+        target.merge_all(lists.begin(), lists.end());
+        if (!equal(all, target))
+            return false;
+        for (int i = 0; i < 6; ++i)
+            if (!lists[i].empty() || walk(lists[i]) != 0)
+                return false;
+    }
+    return true;
+}
+
+int main() {
+    srand(2653);
+    bool (*testList[])() = {
+            testMergeAll, testPointers, testEmpty, testBint, testException
+    };
+    const char* Messages[] = {
+            "Test 1: Testing merge_all() of 1 to 100 lists...",
+            "Test 2: Testing ranges of pointers, repeats and *this...",
+            "Test 3: Testing empty lists...",
+            "Test 4: Testing class-bint...",
+            "Test 5: Testing exception safety..."
+    };
+
+    bool okay = true;
+    for (int i = 0; i < sizeof(testList) / sizeof(testList[0]); ++i) {
+        printf("%s", Messages[i]);
+        if (testList[i]()){
+            printf("Passed\n");
+        } else {
+            okay = false;
+            printf("Failed\n");
+        }
+    }
+
+    if (okay)
+        printf("Congratulations, you have passed all tests!\n");
+    else printf("Unfortunately, you failed in some of the tests.\n");
+    return 0;
+}
@@ -0,0 +1,157 @@
+#define SJTU_LIST_ENABLE_THREADS
+
+#include "class-bint.hpp"
+#include "small_list.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <vector>
+
+const int N = 2e5;
+
+bool armed = false; // comparing a Record with key -1 throws while set
+
+/**
+ * compared by key only, id tells equivalent records apart
+ */
+class Record {
+public:
+    int key, id;
+    Record(int k, int i): key(k), id(i) {}
+    Record(const Record &other): key(other.key), id(other.id) {}
+    bool operator<(const Record &rhs) const {
+        if (armed && (key == -1 || rhs.key == -1)) throw 1;
+        return key < rhs.key;
+    }
+    bool operator==(const Record &rhs) const { return key == rhs.key && id == rhs.id; }
+};
+
+template<typename T>
+bool equal(const std::vector<T> &x, const sjtu::list<T> &y) {
+    if (x.size() != y.size())
+        return false;
+    typename sjtu::list<T>::const_iterator ity = y.cbegin();
+    for (size_t i = 0; i < x.size(); ++i, ++ity)
+        if (!(x[i] == *ity))
+            return false;
+    return ity == y.cend();
+}
+
+/**
+ * n sorted records with keys below range; ids start at base
+ */
+void build(int n, int range, int base, std::vector<Record> &ans, sjtu::list<Record> &myList) {
+    std::vector<int> keys;
+    for (int i = 0; i < n; ++i)
+        keys.push_back(rand() % range);
+    std::sort(keys.begin(), keys.end());
+    for (int i = 0; i < n; ++i) {
+        ans.push_back(Record(keys[i], base + i));
+        myList.push_back(Record(keys[i], base + i));
+    }
+}
+
+bool check(int n, int m, int range, unsigned threads) {
+    std::vector<Record> x, y, ans;
+    sjtu::list<Record> a, b;
+    build(n, range, 0, x, a);
+    build(m, range, n, y, b);
+    std::merge(x.begin(), x.end(), y.begin(), y.end(), std::back_inserter(ans));
+    a.merge_parallel(b, threads);
+    if (!equal(ans, a) || !b.empty())
+        return false;
+    b.push_back(Record(0, 0));
+    return b.size() == 1 && a.size() == ans.size();
+}
+
+bool testThreads() {
+    for (unsigned threads = 0; threads <= 8; ++threads)
+        if (!check(N, N, 4 * N, threads))
+            return false;
+    return true;
+}
+
+bool testShapes() {
+    return check(N, 10, 1000, 4) && check(10, N, 1000, 4) && check(N / 2, N, 3, 3) &&
+           check(2000, 2095, 100, 4) && check(2048, 2048, 100, 4) && check(1, 1, 1, 8) &&
+           check(0, 5000, 10, 4) && check(5000, 0, 10, 4);
+}
+
+bool testSmallList() {
+    std::vector<Record> x, y, ans;
+    sjtu::list<Record> a;
+    sjtu::small_list<Record, 8> b;
+    build(N, 100, 0, x, a);
+    build(20, 100, N, y, b);
+    std::merge(x.begin(), x.end(), y.begin(), y.end(), std::back_inserter(ans));
+    a.merge_parallel(b, 4);
+    return equal(ans, a) && b.empty() && b.inline_available() == 8;
+}
+
+bool testBint() {
+    std::vector<Util::Bint> x, y, ans;
+    sjtu::list<Util::Bint> a, b;
+    for (int i = 0; i < 5000; ++i) {
+        x.push_back(Util::Bint(rand()) * Util::Bint(rand() % 100));
+        y.push_back(Util::Bint(rand()) * Util::Bint(rand() % 100));
+    }
+    std::sort(x.begin(), x.end());
+    std::sort(y.begin(), y.end());
+    for (int i = 0; i < 5000; ++i) {
+        a.push_back(x[i]);
+        b.push_back(y[i]);
+    }
+    std::merge(x.begin(), x.end(), y.begin(), y.end(), std::back_inserter(ans));
+    a.merge_parallel(b, 4);
+    return equal(ans, a);
+}
+
+bool testException() {
+    std::vector<Record> x, y;
+    sjtu::list<Record> a, b;
+    a.push_back(Record(-1, -1));
+    x.push_back(Record(-1, -1));
+    build(N, 1000, 0, x, a);
+    build(N, 1000, N, y, b);
+    armed = true;
+    try {
+        a.merge_parallel(b, 4);
+    } catch (int) {
+        armed = false;
+        return equal(x, a) && equal(y, b);
+    }
+    armed = false;
+    return false;
+}
+
+int main() {
+    srand(2653);
+    bool (*testList[])() = {
+            testThreads, testShapes, testSmallList, testBint, testException
+    };
+    const char* Messages[] = {
+            "Test 1: Testing merge_parallel() with 0 to 8 threads...",
+            "Test 2: Testing skewed, tiny and empty inputs...",
+            "Test 3: Testing merge_parallel() of a small_list...",
+            "Test 4: Testing class-bint...",
+            "Test 5: Testing exception safety..."
+    };
+
+    bool okay = true;
+    for (int i = 0; i < sizeof(testList) / sizeof(testList[0]); ++i) {
+        printf("%s", Messages[i]);
+        if (testList[i]()){
+            printf("Passed\n");
+        } else {
+            okay = false;
+            printf("Failed\n");
+        }
+    }
+
+    if (okay)
+        printf("Congratulations, you have passed all tests!\n");
+    else printf("Unfortunately, you failed in some of the tests.\n");
+    return 0;
+}
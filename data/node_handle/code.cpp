@@ -0,0 +1,207 @@
+#include "class-bint.hpp"
+#include "list.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+
+const int N = 2e4;
+
+template<typename T>
+bool equal(const std::list<T> &x, const sjtu::list<T> &y) {
+    if (x.size() != y.size())
+        return false;
+    typename std::list<T>::const_iterator itx = x.cbegin();
+    typename sjtu::list<T>::const_iterator ity = y.cbegin();
+    for (; itx != x.cend() && ity != y.cend(); ++itx, ++ity)
+        if (!(*itx == *ity))
+            return false;
+    return ity == y.cend();
+}
+
+int copies = 0, alive = 0;
+
+class Counted {
+public:
+    int val;
+    Counted(int v): val(v) { ++alive; }
+    Counted(const Counted &other): val(other.val) {
+        ++copies;
+        ++alive;
+    }
+    ~Counted() { --alive; }
+    bool operator==(const Counted &rhs) const { return val == rhs.val; }
+};
+
+typedef sjtu::list<int>::node_handle handle;
+
+bool testMove() {
+    std::list<int> ansA, ansB;
+    sjtu::list<int> a, b;
+    for (int i = 0; i < N; ++i) {
+        int x = rand();
+        ansA.push_back(x);
+        a.push_back(x);
+    }
+    for (int i = 0; i < N; ++i) {
+        size_t from = rand() % 50, to = rand() % (ansB.size() + 1);
+        if (from >= ansA.size())
+            from = 0;
+        std::list<int>::iterator fa = ansA.begin(), ta = ansB.begin();
+        sjtu::list<int>::iterator fb = a.begin(), tb = b.begin();
+        for (size_t j = 0; j < from; ++j, ++fa, ++fb);
+        for (size_t j = 0; j < to && j < 50; ++j, ++ta, ++tb);
+        ansB.splice(ta, ansA, fa);
+        handle nh = a.extract(fb);
+        int *addr = &nh.value();
+        sjtu::list<int>::iterator it = b.insert(tb, static_cast<handle &&>(nh));
+        if (&*it != addr || !nh.empty() || a.size() != ansA.size() || b.size() != ansB.size())
+            return false;
+    }
+    return equal(ansA, a) && equal(ansB, b);
+}
+
+bool testNoCopy() {
+    copies = 0;
+    {
+        sjtu::list<Counted> a, b;
+        for (int i = 0; i < 1000; ++i)
+            a.push_back(Counted(i));
+        copies = 0;
+        while (!a.empty()) {
+            sjtu::list<Counted>::node_handle nh = a.extract(a.begin());
+            nh.value().val *= 2;
+            b.insert(b.begin(), static_cast<sjtu::list<Counted>::node_handle &&>(nh));
+        }
+        if (copies != 0 || alive != 1000)
+            return false;
+        int i = 999;
+        for (sjtu::list<Counted>::iterator it = b.begin(); it != b.end(); ++it, --i)
+            if (it->val != i * 2)
+                return false;
+        {
+            sjtu::list<Counted>::node_handle dropped = b.extract(b.begin());
+            sjtu::list<Counted>::node_handle other;
+            other = static_cast<sjtu::list<Counted>::node_handle &&>(dropped);
+            if (dropped || !other || alive != 1000)
+                return false;
+        }
+        if (alive != 999 || b.size() != 999)
+            return false;
+    }
+    return alive == 0 && copies == 0;
+}
+
+bool testBlocks() {
+    std::list<int> ans;
+    sjtu::list<int> a, b;
+    a.reserve(100);
+    a.retain_nodes();
+    for (int i = 0; i < 100; ++i)
+        a.push_back(i);
+    {
+        sjtu::list<int> c(a.begin(), a.end());
+        c.compact();
+        for (int i = 0; i < 50; ++i) {
+            b.insert(b.end(), a.extract(a.begin()));
+            b.insert(b.end(), c.extract(--c.end()));
+            ans.push_back(i);
+            ans.push_back(99 - i);
+        }
+    }
+    a.clear();
+    a.shrink_to_fit();
+    for (int i = 0; i < 10; ++i)
+        a.push_back(i);
+    b.sort();
+    ans.sort();
+    return equal(ans, b) && a.size() == 10;
+}
+
+bool testBint() {
+    std::list<Util::Bint> ans;
+    sjtu::list<Util::Bint> a, b;
+    for (int i = 0; i < 500; ++i) {
+        Util::Bint x = Util::Bint(rand()) * Util::Bint(rand());
+        a.push_back(x);
+        if (i % 2)
+            ans.push_back(x);
+    }
+    sjtu::list<Util::Bint>::iterator it = a.begin();
+    for (int i = 0; i < 250; ++i) {
+        ++it;
+        sjtu::list<Util::Bint>::iterator next = it;
+        ++next;
+        b.insert(b.end(), a.extract(it));
+        it = next;
+    }
+    return equal(ans, b) && a.size() == 250;
+}
+
+bool testException() {
+    sjtu::list<int> a, b;
+    int caught = 0;
+    try {
+        a.extract(a.begin());
+    } catch (...) {
+        ++caught;
+    }
+    a.push_back(1);
+    b.push_back(2);
+    try {
+        a.extract(b.begin());
+    } catch (sjtu::invalid_iterator) {
+        ++caught;
+    }
+    try {
+        a.extract(a.end());
+    } catch (sjtu::invalid_iterator) {
+        ++caught;
+    }
+    handle nh = a.extract(a.begin());
+    try {
+        a.insert(b.begin(), static_cast<handle &&>(nh));
+    } catch (sjtu::invalid_iterator) {
+        ++caught;
+    }
+    handle empty;
+    try {
+        empty.value();
+    } catch (sjtu::container_is_empty) {
+        ++caught;
+    }
+    if (a.insert(a.end(), static_cast<handle &&>(empty)) != a.end() || !a.empty())
+        return false;
+    a.insert(a.end(), static_cast<handle &&>(nh));
+    return caught == 5 && a.size() == 1 && a.front() == 1 && b.size() == 1;
+}
+
+int main() {
+    srand(2653);
+    bool (*testList[])() = {
+            testMove, testNoCopy, testBlocks, testBint, testException
+    };
+    const char* Messages[] = {
+            "Test 1: Testing extract() and insert(node_handle) between lists...",
+            "Test 2: Testing that no element is copied...",
+            "Test 3: Testing nodes from blocks and retained lists...",
+            "Test 4: Testing class-bint...",
+            "Test 5: Testing exception throw..."
+    };
+
+    bool okay = true;
+    for (int i = 0; i < sizeof(testList) / sizeof(testList[0]); ++i) {
+        printf("%s", Messages[i]);
+        if (testList[i]()){
+            printf("Passed\n");
+        } else {
+            okay = false;
+            printf("Failed\n");
+        }
+    }
+
+    if (okay)
+        printf("Congratulations, you have passed all tests!\n");
+    else printf("Unfortunately, you failed in some of the tests.\n");
+    return 0;
+}
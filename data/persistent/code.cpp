@@ -0,0 +1,172 @@
+#include "class-bint.hpp"
+#include "persistent_list.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+const int N = 3e4;
+
+template<typename T>
+bool equal(const std::vector<T> &x, const sjtu::persistent_list<T> &y) {
+    if (x.size() != y.size())
+        return false;
+    typename sjtu::persistent_list<T>::const_iterator ity = y.cbegin();
+    for (size_t i = 0; i < x.size(); ++i, ++ity)
+        if (!(x[i] == *ity) || !(x[i] == y[i]))
+            return false;
+    return ity == y.cend();
+}
+
+bool testPush() {
+    std::vector<int> ans;
+    sjtu::persistent_list<int> v;
+    for (int i = 0; i < N; ++i) {
+        if (i % 3) {
+            ans.push_back(i);
+            v = v.push_back(i);
+        } else {
+            ans.insert(ans.begin(), i);
+            v = v.push_front(i);
+        }
+    }
+    return equal(ans, v) && v.front() == ans.front() && v.back() == ans.back();
+}
+
+bool testVersions() {
+    std::vector<std::vector<int> > ans(1);
+    std::vector<sjtu::persistent_list<int> > versions(1);
+    for (int i = 0; i < 2000; ++i) {
+        size_t from = rand() % versions.size();
+        std::vector<int> a = ans[from];
+        sjtu::persistent_list<int> v = versions[from];
+        int op = rand() % 4;
+        if (op < 2 || a.empty()) {
+            size_t k = rand() % (a.size() + 1);
+            a.insert(a.begin() + k, i);
+            v = v.insert(k, i);
+        } else if (op == 2) {
+            size_t k = rand() % a.size();
+            a.erase(a.begin() + k);
+            v = v.erase(k);
+        } else {
+            size_t k = rand() % a.size();
+            a[k] = -i;
+            v = v.set(k, -i);
+        }
+        ans.push_back(a);
+        versions.push_back(v);
+    }
+    for (size_t i = 0; i < versions.size(); ++i)
+        if (!equal(ans[i], versions[i]))
+            return false;
+    return true;
+}
+
+bool testPop() {
+    std::vector<int> ans;
+    sjtu::persistent_list<int> v;
+    for (int i = 0; i < N; ++i) {
+        ans.push_back(i);
+        v = v.push_back(i);
+    }
+    sjtu::persistent_list<int> full = v;
+    for (int i = 0; i < N / 2; ++i) {
+        if (i % 2) {
+            ans.pop_back();
+            v = v.pop_back();
+        } else {
+            ans.erase(ans.begin());
+            v = v.pop_front();
+        }
+    }
+    return equal(ans, v) && full.size() == (size_t)N && full[N - 1] == N - 1;
+}
+
+bool testConcatSelf() {
+    std::vector<int> ans;
+    sjtu::persistent_list<int> v;
+    for (int i = 0; i < 8; ++i) {
+        ans.push_back(i);
+        v = v.push_back(i);
+    }
+    // every doubling joins two trees made of the very same nodes
+    for (int i = 0; i < 17; ++i)
+        v = v.concat(v);
+    const size_t n = (size_t)8 << 17, mid = n / 2 + 1;
+    v = v.push_front(-1).push_back(-2);
+    v = v.insert(mid, -3);
+    if (v.size() != n + 3)
+        return false;
+    if (v[0] != -1 || v[n + 2] != -2 || v[mid] != -3 || v[mid + 1] != ans[(mid - 1) % 8])
+        return false;
+    for (int i = 0; i < 1000; ++i) {
+        size_t k = rand() % (v.size() / 2 - 1);
+        if (v[k + 1] != ans[k % 8])
+            return false;
+    }
+    return true;
+}
+
+bool testBint() {
+    std::vector<Util::Bint> ans;
+    sjtu::persistent_list<Util::Bint> v;
+    for (int i = 0; i < 1000; ++i) {
+        Util::Bint x(rand());
+        ans.push_back(x);
+        v = v.push_back(x);
+    }
+    sjtu::persistent_list<Util::Bint> w = v.erase(500).concat(v);
+    std::vector<Util::Bint> expect;
+    for (int i = 0; i < 1000; ++i)
+        if (i != 500)
+            expect.push_back(ans[i]);
+    for (int i = 0; i < 1000; ++i)
+        expect.push_back(ans[i]);
+    return equal(expect, w) && equal(ans, v);
+}
+
+bool testException() {
+    sjtu::persistent_list<int> v;
+    int caught = 0;
+    try { v.front(); } catch (sjtu::container_is_empty &) { ++caught; }
+    try { v.pop_back(); } catch (sjtu::container_is_empty &) { ++caught; }
+    try { v.insert(1, 0); } catch (sjtu::index_out_of_bound &) { ++caught; }
+    v = v.push_back(1);
+    try { v[1]; } catch (sjtu::index_out_of_bound &) { ++caught; }
+    try { v.erase(1); } catch (sjtu::index_out_of_bound &) { ++caught; }
+    try { *v.cend(); } catch (sjtu::invalid_iterator &) { ++caught; }
+    try { --v.cbegin(); } catch (sjtu::invalid_iterator &) { ++caught; }
+    return caught == 7;
+}
+
+int main() {
+    srand(2653);
+    bool (*testList[])() = {
+            testPush, testVersions, testPop, testConcatSelf, testBint, testException
+    };
+    const char *Messages[] = {
+            "Test 1: Testing push_front & push_back...",
+            "Test 2: Testing insert, erase & set on old versions...",
+            "Test 3: Testing pop_front & pop_back...",
+            "Test 4: Testing concat of a version with itself...",
+            "Test 5: Testing class-bint...",
+            "Test 6: Testing exception throw..."
+    };
+
+    bool okay = true;
+    for (size_t i = 0; i < sizeof(testList) / sizeof(testList[0]); ++i) {
+        printf("%s", Messages[i]);
+        if (testList[i]()) {
+            printf("Passed\n");
+        } else {
+            okay = false;
+            printf("Failed\n");
+        }
+    }
+
+    if (okay)
+        printf("Congratulations, you have passed all tests!\n");
+    else printf("Unfortunately, you failed in some of the tests.\n");
+    return 0;
+}
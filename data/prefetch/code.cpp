@@ -0,0 +1,163 @@
+#include "class-matrix.hpp"
+#include "list.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+
+const int N = 1e5;
+
+template<typename T>
+bool equal(const std::list<T> &x, const sjtu::list<T> &y) {
+    if (x.size() != y.size())
+        return false;
+    typename std::list<T>::const_iterator itx = x.cbegin();
+    typename sjtu::list<T>::const_iterator ity = y.cbegin();
+    for (; itx != x.cend() && ity != y.cend(); ++itx, ++ity)
+        if (!(*itx == *ity))
+            return false;
+    return ity == y.cend();
+}
+
+bool testTraversal() {
+    const size_t sizes[] = {0, 1, 7, 8, 9, 17, (size_t)N};
+    for (size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); ++k) {
+        std::list<int> ans;
+        sjtu::list<int> myList;
+        for (size_t i = 0; i < sizes[k]; ++i) {
+            int x = rand();
+            ans.push_back(x);
+            myList.push_back(x);
+        }
+        std::list<int>::iterator a = ans.begin();
+        size_t cnt = 0;
+        for (sjtu::list<int>::prefetch_iterator it = myList.prefetch_begin(); it != myList.end(); ++it, ++a, ++cnt)
+            if (*it != *a)
+                return false;
+        if (cnt != sizes[k] || a != ans.end())
+            return false;
+    }
+    return true;
+}
+
+bool testModify() {
+    std::list<int> ans;
+    sjtu::list<int> myList;
+    for (int i = 0; i < N; ++i) {
+        ans.push_back(i);
+        myList.push_back(i);
+    }
+    for (std::list<int>::iterator it = ans.begin(); it != ans.end(); ++it)
+        *it = *it * 3 + 1;
+    for (sjtu::list<int>::prefetch_iterator it = myList.prefetch_begin(); it != myList.end(); it++)
+        *it = *it * 3 + 1;
+    return equal(ans, myList);
+}
+
+bool testFromIterator() {
+    sjtu::list<int> myList;
+    for (int i = 0; i < 100; ++i)
+        myList.push_back(i);
+    sjtu::list<int>::iterator mid = myList.begin();
+    for (int i = 0; i < 95; ++i)
+        ++mid;
+    sjtu::list<int>::prefetch_iterator it(mid);
+    long long sum = 0;
+    for (; it != myList.end(); ++it)
+        sum += *it;
+    if (sum != 95 + 96 + 97 + 98 + 99)
+        return false;
+    sjtu::list<int>::prefetch_iterator e(myList.end());
+    return e == myList.end();
+}
+
+bool testMatrix() {
+    std::list<Diamond::Matrix<double> > ans;
+    sjtu::list<Diamond::Matrix<double> > myList;
+    for (int i = 0; i < 500; ++i) {
+        Diamond::Matrix<double> m(2, 2, rand() % 100);
+        ans.push_back(m);
+        myList.push_back(m);
+    }
+    std::list<Diamond::Matrix<double> >::iterator a = ans.begin();
+    for (sjtu::list<Diamond::Matrix<double> >::prefetch_iterator it = myList.prefetch_begin(); it != myList.end(); ++it, ++a)
+        if (!(it->RowSize() == 2 && *it == *a))
+            return false;
+    return a == ans.end();
+}
+
+bool testEraseAhead() {
+    std::list<int> ans;
+    sjtu::list<int> myList;
+    for (int i = 0; i < N; ++i) {
+        ans.push_back(i);
+        myList.push_back(i);
+    }
+    // erase and insert a few nodes ahead of the iterator while walking
+    std::list<int>::iterator a = ans.begin();
+    for (sjtu::list<int>::prefetch_iterator it = myList.prefetch_begin(); it != myList.end(); ++it, ++a) {
+        if (*it != *a)
+            return false;
+        int k = 1 + rand() % 10;
+        std::list<int>::iterator pa = a;
+        sjtu::list<int>::iterator pb = it;
+        for (int j = 0; j < k && pa != ans.end(); ++j, ++pa, ++pb);
+        if (pa == ans.end())
+            continue;
+        if (rand() % 3) {
+            ans.erase(pa);
+            myList.erase(pb);
+        } else {
+            ans.insert(pa, -*a);
+            myList.insert(pb, -*a);
+        }
+    }
+    return a == ans.end() && equal(ans, myList);
+}
+
+bool testException() {
+    sjtu::list<int> myList;
+    for (int i = 0; i < 3; ++i)
+        myList.push_back(i);
+    sjtu::list<int>::prefetch_iterator it = myList.prefetch_begin();
+    ++it, ++it, ++it;
+    if (it != myList.end())
+        return false;
+    try {
+        ++it;
+    } catch (...) {
+        return true;
+    }
+    return false;
+}
+
+int main() {
+    srand(2653);
+    bool (*testList[])() = {
+            testTraversal, testModify, testFromIterator, testMatrix, testEraseAhead, testException
+    };
+    const char* Messages[] = {
+            "Test 1: Testing traversal with prefetch_begin()...",
+            "Test 2: Testing modification through a prefetch_iterator...",
+            "Test 3: Testing prefetch_iterator from an iterator...",
+            "Test 4: Testing class-Matrix...",
+            "Test 5: Testing erase() and insert() ahead of a prefetch_iterator...",
+            "Test 6: Testing exception throw..."
+    };
+
+    bool okay = true;
+    for (int i = 0; i < sizeof(testList) / sizeof(testList[0]); ++i) {
+        printf("%s", Messages[i]);
+        if (testList[i]()){
+            printf("Passed\n");
+        } else {
+            okay = false;
+            printf("Failed\n");
+        }
+    }
+
+    if (okay)
+        printf("Congratulations, you have passed all tests!\n");
+    else printf("Unfortunately, you failed in some of the tests.\n");
+    return 0;
+}
@@ -0,0 +1,174 @@
+#include "list.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// every member must compile for a type that is neither integral nor saved without a codec
+template class sjtu::list<std::string>;
+
+const int N = 1e5;
+
+template<typename T>
+bool equal(const std::vector<T> &x, const sjtu::list<T> &y) {
+    if (x.size() != y.size())
+        return false;
+    typename sjtu::list<T>::const_iterator ity = y.cbegin();
+    for (size_t i = 0; i < x.size(); ++i, ++ity)
+        if (!(x[i] == *ity))
+            return false;
+    return ity == y.cend();
+}
+
+/**
+ * a random value spread over the whole range of T
+ */
+template<typename T>
+T randomValue() {
+    unsigned long long x = 0;
+    for (int i = 0; i < 4; ++i)
+        x = x << 16 ^ (rand() & 0xffff);
+    return (T)x;
+}
+
+template<typename T>
+bool checkSort(size_t n) {
+    std::vector<T> ans;
+    sjtu::list<T> myList;
+    for (size_t i = 0; i < n; ++i) {
+        T x = randomValue<T>();
+        ans.push_back(x);
+        myList.push_back(x);
+    }
+    std::sort(ans.begin(), ans.end());
+    myList.sort();
+    return equal(ans, myList);
+}
+
+struct Record {
+    int key, id;
+    bool operator<(const Record &rhs) const { return key < rhs.key; }
+    bool operator==(const Record &rhs) const { return key == rhs.key && id == rhs.id; }
+};
+
+int keyCalls = 0;
+
+struct KeyOf {
+    int operator()(const Record &r) const {
+        ++keyCalls;
+        return r.key;
+    }
+};
+
+bool testIntegral() {
+    return checkSort<int>(N) && checkSort<long long>(N) && checkSort<unsigned int>(N) &&
+           checkSort<short>(N) && checkSort<unsigned char>(N) && checkSort<signed char>(N) &&
+           checkSort<unsigned long long>(N) && checkSort<char>(1000);
+}
+
+bool testSizes() {
+    for (size_t n = 0; n < 600; n += 7)
+        if (!checkSort<int>(n) || !checkSort<long long>(n))
+            return false;
+    return checkSort<int>(255) && checkSort<int>(256) && checkSort<int>(257);
+}
+
+bool testExtremes() {
+    std::vector<int> ans;
+    sjtu::list<int> myList;
+    const int special[] = {INT_MIN, INT_MAX, -1, 0, 1, INT_MIN + 1, INT_MAX - 1};
+    for (int i = 0; i < 1000; ++i) {
+        int x = i % 3 ? special[rand() % 7] : rand() % 200 - 100;
+        ans.push_back(x);
+        myList.push_back(x);
+    }
+    std::sort(ans.begin(), ans.end());
+    myList.sort();
+    if (!equal(ans, myList))
+        return false;
+    std::vector<long long> ansLong;
+    sjtu::list<long long> longList;
+    for (int i = 0; i < 1000; ++i) {
+        long long x = i % 2 ? LLONG_MIN + i : LLONG_MAX - i;
+        ansLong.push_back(x);
+        longList.push_back(x);
+    }
+    std::sort(ansLong.begin(), ansLong.end());
+    longList.sort();
+    return equal(ansLong, longList);
+}
+
+bool testKey() {
+    std::vector<Record> ans;
+    sjtu::list<Record> myList;
+    for (int i = 0; i < N; ++i) {
+        Record r = {rand() % 2000 - 1000, i};
+        ans.push_back(r);
+        myList.push_back(r);
+    }
+    std::stable_sort(ans.begin(), ans.end());
+    keyCalls = 0;
+    myList.radix_sort(KeyOf());
+    if (keyCalls != N || !equal(ans, myList))
+        return false;
+    for (size_t i = 0; i < ans.size(); ++i)
+        ans[i].key = -ans[i].key;
+    std::stable_sort(ans.begin(), ans.end());
+    myList.radix_sort([](const Record &r) { return (long long)r.key * -1; });
+    for (size_t i = 0; i < ans.size(); ++i)
+        ans[i].key = -ans[i].key;
+    return equal(ans, myList);
+}
+
+bool testException() {
+    std::vector<Record> ans;
+    sjtu::list<Record> myList;
+    for (int i = 0; i < 1000; ++i) {
+        Record r = {rand(), i};
+        ans.push_back(r);
+        myList.push_back(r);
+    }
+    int calls = 0;
+    try {
+        myList.radix_sort([&calls](const Record &r) {
+            if (++calls == 500) throw 1;
+            return r.key;
+        });
+    } catch (int) {
+        return equal(ans, myList);
+    }
+    return false;
+}
+
+int main() {
+    srand(2653);
+    bool (*testList[])() = {
+            testIntegral, testSizes, testExtremes, testKey, testException
+    };
+    const char* Messages[] = {
+            "Test 1: Testing sort() of integral types...",
+            "Test 2: Testing sizes around the radix threshold...",
+            "Test 3: Testing extreme values...",
+            "Test 4: Testing stability of radix_sort(key)...",
+            "Test 5: Testing exception safety..."
+    };
+
+    bool okay = true;
+    for (int i = 0; i < sizeof(testList) / sizeof(testList[0]); ++i) {
+        printf("%s", Messages[i]);
+        if (testList[i]()){
+            printf("Passed\n");
+        } else {
+            okay = false;
+            printf("Failed\n");
+        }
+    }
+
+    if (okay)
+        printf("Congratulations, you have passed all tests!\n");
+    else printf("Unfortunately, you failed in some of the tests.\n");
+    return 0;
+}
@@ -0,0 +1,183 @@
+#include "class-bint.hpp"
+#include "list.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+
+const int N = 5e4;
+
+template<typename T>
+bool equal(const std::list<T> &x, const sjtu::list<T> &y) {
+    if (x.size() != y.size())
+        return false;
+    typename std::list<T>::const_iterator itx = x.cbegin();
+    typename sjtu::list<T>::const_iterator ity = y.cbegin();
+    for (; itx != x.cend() && ity != y.cend(); ++itx, ++ity)
+        if (!(*itx == *ity))
+            return false;
+    return ity == y.cend();
+}
+
+bool testRangeErase() {
+    std::list<int> ans;
+    sjtu::list<int> myList;
+    for (int i = 0; i < N; ++i) {
+        ans.push_back(i);
+        myList.push_back(i);
+    }
+    while (!ans.empty()) {
+        size_t from = rand() % ans.size(), len = rand() % 300;
+        if (from + len > ans.size())
+            len = ans.size() - from;
+        std::list<int>::iterator a = ans.begin(), b;
+        sjtu::list<int>::iterator c = myList.begin(), d;
+        for (size_t i = 0; i < from; ++i, ++a, ++c);
+        b = a, d = c;
+        for (size_t i = 0; i < len; ++i, ++b, ++d);
+        std::list<int>::iterator ra = ans.erase(a, b);
+        sjtu::list<int>::iterator rc = myList.erase(c, d);
+        if (rc != d || (ra != ans.end() && *ra != *rc))
+            return false;
+        if (ans.size() % 97 == 0 && !equal(ans, myList))
+            return false;
+    }
+    return equal(ans, myList);
+}
+
+bool testWholeRange() {
+    sjtu::list<int> myList;
+    for (int i = 0; i < 100; ++i)
+        myList.push_back(i);
+    sjtu::list<int>::iterator it = myList.erase(myList.begin(), myList.begin());
+    if (it != myList.begin() || myList.size() != 100)
+        return false;
+    it = myList.erase(myList.begin(), myList.end());
+    if (it != myList.end() || !myList.empty())
+        return false;
+    myList.push_back(1);
+    return myList.front() == 1 && myList.back() == 1;
+}
+
+bool testBulkPop() {
+    std::list<int> ans;
+    sjtu::list<int> myList;
+    for (int i = 0; i < N; ++i) {
+        ans.push_back(i);
+        myList.push_back(i);
+    }
+    while (!ans.empty()) {
+        size_t n = rand() % 500;
+        if (n > ans.size())
+            n = ans.size();
+        if (rand() % 2) {
+            for (size_t i = 0; i < n; ++i)
+                ans.pop_back();
+            myList.pop_back(n);
+        } else {
+            for (size_t i = 0; i < n; ++i)
+                ans.pop_front();
+            myList.pop_front(n);
+        }
+        if (!ans.empty() && (myList.front() != ans.front() || myList.back() != ans.back()))
+            return false;
+    }
+    return equal(ans, myList);
+}
+
+bool testBint() {
+    std::list<Util::Bint> ans;
+    sjtu::list<Util::Bint> myList;
+    for (int i = 0; i < 1000; ++i) {
+        Util::Bint x = Util::Bint(rand()) * Util::Bint(rand());
+        ans.push_back(x);
+        myList.push_back(x);
+    }
+    std::list<Util::Bint>::iterator a = ans.begin();
+    sjtu::list<Util::Bint>::iterator c = myList.begin();
+    for (int i = 0; i < 200; ++i, ++a, ++c);
+    std::list<Util::Bint>::iterator b = a;
+    sjtu::list<Util::Bint>::iterator d = c;
+    for (int i = 0; i < 300; ++i, ++b, ++d);
+    ans.erase(a, b);
+    myList.erase(c, d);
+    for (int i = 0; i < 100; ++i) {
+        ans.pop_back();
+        ans.pop_front();
+    }
+    myList.pop_back(100);
+    myList.pop_front(100);
+    return equal(ans, myList);
+}
+
+bool testException() {
+    sjtu::list<int> myList, other;
+    for (int i = 0; i < 10; ++i) {
+        myList.push_back(i);
+        other.push_back(i);
+    }
+    int caught = 0;
+    try {
+        myList.pop_back(11);
+    } catch (sjtu::container_is_empty) {
+        ++caught;
+    }
+    try {
+        myList.pop_front(11);
+    } catch (sjtu::container_is_empty) {
+        ++caught;
+    }
+    try {
+        myList.erase(myList.begin(), other.end());
+    } catch (sjtu::invalid_iterator) {
+        ++caught;
+    }
+    try {
+        sjtu::list<int>::iterator first = ++myList.begin();
+        myList.erase(first, myList.begin());
+    } catch (sjtu::invalid_iterator) {
+        ++caught;
+    }
+    try {
+        myList.erase(myList.end(), myList.begin());
+    } catch (sjtu::invalid_iterator) {
+        ++caught;
+    }
+    myList.pop_back(0);
+    myList.pop_front(0);
+    int i = 0;
+    for (sjtu::list<int>::iterator it = myList.begin(); it != myList.end(); ++it, ++i)
+        if (*it != i)
+            return false;
+    return caught == 5 && i == 10;
+}
+
+int main() {
+    srand(2653);
+    bool (*testList[])() = {
+            testRangeErase, testWholeRange, testBulkPop, testBint, testException
+    };
+    const char* Messages[] = {
+            "Test 1: Testing erase(first, last)...",
+            "Test 2: Testing empty and whole ranges...",
+            "Test 3: Testing pop_back(n) & pop_front(n)...",
+            "Test 4: Testing class-bint...",
+            "Test 5: Testing exception throw..."
+    };
+
+    bool okay = true;
+    for (int i = 0; i < sizeof(testList) / sizeof(testList[0]); ++i) {
+        printf("%s", Messages[i]);
+        if (testList[i]()){
+            printf("Passed\n");
+        } else {
+            okay = false;
+            printf("Failed\n");
+        }
+    }
+
+    if (okay)
+        printf("Congratulations, you have passed all tests!\n");
+    else printf("Unfortunately, you failed in some of the tests.\n");
+    return 0;
+}
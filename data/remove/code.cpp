@@ -0,0 +1,140 @@
+#include "class-bint.hpp"
+#include "list.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+
+const int N = 1e5;
+
+template<typename T>
+bool equal(const std::list<T> &x, const sjtu::list<T> &y) {
+    if (x.size() != y.size())
+        return false;
+    typename std::list<T>::const_iterator itx = x.cbegin();
+    typename sjtu::list<T>::const_iterator ity = y.cbegin();
+    for (; itx != x.cend() && ity != y.cend(); ++itx, ++ity)
+        if (!(*itx == *ity))
+            return false;
+    return ity == y.cend();
+}
+
+struct Odd {
+    bool operator()(int x) const { return x % 2 != 0; }
+};
+
+bool testRemove() {
+    std::list<int> ans;
+    sjtu::list<int> myList;
+    for (int i = 0; i < N; ++i) {
+        int x = rand() % 100;
+        ans.push_back(x);
+        myList.push_back(x);
+    }
+    for (int v = 0; v < 100; v += 7) {
+        size_t before = ans.size();
+        ans.remove(v);
+        if (myList.remove(v) != before - ans.size() || !equal(ans, myList))
+            return false;
+    }
+    return myList.remove(1000) == 0 && equal(ans, myList);
+}
+
+bool testRemoveIf() {
+    std::list<int> ans;
+    sjtu::list<int> myList;
+    for (int i = 0; i < N; ++i) {
+        int x = rand();
+        ans.push_back(x);
+        myList.push_back(x);
+    }
+    size_t before = ans.size();
+    ans.remove_if(Odd());
+    if (myList.remove_if(Odd()) != before - ans.size() || !equal(ans, myList))
+        return false;
+    int limit = RAND_MAX / 2;
+    before = ans.size();
+    ans.remove_if([limit](int x) { return x > limit; });
+    if (myList.remove_if([limit](int x) { return x > limit; }) != before - ans.size())
+        return false;
+    if (!equal(ans, myList))
+        return false;
+    myList.remove_if([](int) { return true; });
+    myList.push_back(3);
+    return myList.size() == 1 && myList.front() == 3 && myList.back() == 3;
+}
+
+bool testSelfReference() {
+    std::list<int> ans;
+    sjtu::list<int> myList;
+    for (int i = 0; i < 1000; ++i) {
+        ans.push_back(i % 10);
+        myList.push_back(i % 10);
+    }
+    ans.remove(ans.front());
+    return myList.remove(myList.front()) == 100 && equal(ans, myList);
+}
+
+bool testBint() {
+    std::list<Util::Bint> ans;
+    sjtu::list<Util::Bint> myList;
+    for (int i = 0; i < 2000; ++i) {
+        Util::Bint x(rand() % 20);
+        ans.push_back(x);
+        myList.push_back(x);
+    }
+    Util::Bint target(7);
+    ans.remove(target);
+    myList.remove(target);
+    return equal(ans, myList);
+}
+
+bool testException() {
+    std::list<int> ans;
+    sjtu::list<int> myList;
+    for (int i = 0; i < 100; ++i) {
+        if (i >= 50 || i % 3)
+            ans.push_back(i);
+        myList.push_back(i);
+    }
+    int seen = 0;
+    try {
+        myList.remove_if([&seen](int x) {
+            if (++seen > 50) throw 1;
+            return x % 3 == 0;
+        });
+    } catch (int) {
+        return equal(ans, myList);
+    }
+    return false;
+}
+
+int main() {
+    srand(2653);
+    bool (*testList[])() = {
+            testRemove, testRemoveIf, testSelfReference, testBint, testException
+    };
+    const char* Messages[] = {
+            "Test 1: Testing remove()...",
+            "Test 2: Testing remove_if()...",
+            "Test 3: Testing remove() of an element of the list...",
+            "Test 4: Testing class-bint...",
+            "Test 5: Testing exception safety..."
+    };
+
+    bool okay = true;
+    for (int i = 0; i < sizeof(testList) / sizeof(testList[0]); ++i) {
+        printf("%s", Messages[i]);
+        if (testList[i]()){
+            printf("Passed\n");
+        } else {
+            okay = false;
+            printf("Failed\n");
+        }
+    }
+
+    if (okay)
+        printf("Congratulations, you have passed all tests!\n");
+    else printf("Unfortunately, you failed in some of the tests.\n");
+    return 0;
+}
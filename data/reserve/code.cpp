@@ -0,0 +1,188 @@
+#include "class-bint.hpp"
+#include "list.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <new>
+
+const int N = 5e4;
+
+size_t allocations = 0;
+
+void *operator new(size_t size) {
+    ++allocations;
+    void *p = malloc(size ? size : 1);
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+void operator delete(void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+
+template<typename T>
+bool equal(const std::list<T> &x, const sjtu::list<T> &y) {
+    if (x.size() != y.size())
+        return false;
+    typename std::list<T>::const_iterator itx = x.cbegin();
+    typename sjtu::list<T>::const_iterator ity = y.cbegin();
+    for (; itx != x.cend() && ity != y.cend(); ++itx, ++ity)
+        if (!(*itx == *ity))
+            return false;
+    return ity == y.cend();
+}
+
+bool testReserve() {
+    sjtu::list<int> myList;
+    if (myList.capacity() != 0)
+        return false;
+    myList.reserve(N);
+    if (myList.capacity() < (size_t)N || !myList.empty())
+        return false;
+    size_t before = allocations;
+    for (int i = 0; i < N; ++i)
+        myList.push_back(i);
+    if (allocations != before || myList.capacity() != (size_t)N)
+        return false;
+    myList.reserve(10);
+    if (myList.capacity() != (size_t)N)
+        return false;
+    int i = 0;
+    for (sjtu::list<int>::iterator it = myList.begin(); it != myList.end(); ++it, ++i)
+        if (*it != i)
+            return false;
+    return i == N;
+}
+
+bool testRetain() {
+    std::list<int> ans;
+    sjtu::list<int> myList;
+    myList.retain_nodes();
+    for (int i = 0; i < N; ++i)
+        myList.push_back(i);
+    myList.clear();
+    if (myList.capacity() != (size_t)N)
+        return false;
+    size_t before = allocations;
+    for (int round = 0; round < 5; ++round) {
+        myList.clear();
+        for (int i = 0; i < N; ++i) {
+            if (i % 2)
+                myList.push_back(i * 7 + round);
+            else
+                myList.push_front(i * 7 + round);
+        }
+        for (int i = 0; i < 100; ++i) {
+            myList.pop_back();
+            myList.push_back(i);
+        }
+    }
+    if (allocations != before)
+        return false;
+    for (int i = 0; i < N; ++i) {
+        if (i % 2)
+            ans.push_back(i * 7 + 4);
+        else
+            ans.push_front(i * 7 + 4);
+    }
+    for (int i = 0; i < 100; ++i) {
+        ans.pop_back();
+        ans.push_back(i);
+    }
+    return equal(ans, myList);
+}
+
+bool testShrink() {
+    sjtu::list<int> myList;
+    myList.retain_nodes();
+    myList.reserve(1000);
+    for (int i = 0; i < 300; ++i)
+        myList.push_back(i);
+    myList.pop_back(100);
+    if (myList.capacity() != 1000 || myList.size() != 200)
+        return false;
+    myList.shrink_to_fit();
+    if (myList.capacity() != 200)
+        return false;
+    myList.retain_nodes(false);
+    myList.clear();
+    return myList.capacity() == 0 && myList.empty();
+}
+
+bool testRandomOps() {
+    std::list<int> ans;
+    sjtu::list<int> myList;
+    myList.retain_nodes();
+    myList.reserve(2000);
+    for (int i = 0; i < N; ++i) {
+        int op = rand() % 5, x = rand();
+        if (op <= 1) {
+            ans.push_back(x);
+            myList.push_back(x);
+        } else if (op == 2) {
+            ans.push_front(x);
+            myList.push_front(x);
+        } else if (op == 3 && !ans.empty()) {
+            ans.erase(ans.begin());
+            myList.erase(myList.begin());
+        } else if (!ans.empty()) {
+            ans.pop_back();
+            myList.pop_back();
+        }
+        if (myList.capacity() < myList.size())
+            return false;
+    }
+    std::list<int> copy(ans);
+    sjtu::list<int> other(myList);
+    ans.sort();
+    myList.sort();
+    ans.unique();
+    myList.unique();
+    return equal(ans, myList) && equal(copy, other);
+}
+
+bool testBint() {
+    std::list<Util::Bint> ans;
+    sjtu::list<Util::Bint> myList;
+    myList.retain_nodes();
+    myList.reserve(500);
+    for (int round = 0; round < 3; ++round) {
+        ans.clear();
+        myList.clear();
+        for (int i = 0; i < 500; ++i) {
+            Util::Bint x = Util::Bint(rand()) * Util::Bint(rand());
+            ans.push_back(x);
+            myList.push_back(x);
+        }
+    }
+    return equal(ans, myList) && myList.capacity() == 500;
+}
+
+int main() {
+    srand(2653);
+    bool (*testList[])() = {
+            testReserve, testRetain, testShrink, testRandomOps, testBint
+    };
+    const char* Messages[] = {
+            "Test 1: Testing reserve() & capacity()...",
+            "Test 2: Testing retain_nodes()...",
+            "Test 3: Testing shrink_to_fit()...",
+            "Test 4: Testing random operations on retained nodes...",
+            "Test 5: Testing class-bint..."
+    };
+
+    bool okay = true;
+    for (int i = 0; i < sizeof(testList) / sizeof(testList[0]); ++i) {
+        printf("%s", Messages[i]);
+        if (testList[i]()){
+            printf("Passed\n");
+        } else {
+            okay = false;
+            printf("Failed\n");
+        }
+    }
+
+    if (okay)
+        printf("Congratulations, you have passed all tests!\n");
+    else printf("Unfortunately, you failed in some of the tests.\n");
+    return 0;
+}
@@ -0,0 +1,172 @@
+#include "class-bint.hpp"
+#include "list.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <sstream>
+#include <string>
+
+namespace sjtu {
+template<>
+struct element_codec<Util::Bint> {
+    static const bool raw = false;
+    static void encode(std::ostream &os, const Util::Bint &value) {
+        std::ostringstream text;
+        text << value;
+        std::string s = text.str();
+        unsigned int len = s.size();
+        os.write(reinterpret_cast<const char *>(&len), sizeof(len));
+        os.write(s.data(), len);
+    }
+    static Util::Bint decode(std::istream &is) {
+        unsigned int len = 0;
+        if (!is.read(reinterpret_cast<char *>(&len), sizeof(len)) || len > 1000) throw runtime_error();
+        std::string s(len, '0');
+        if (!is.read(&s[0], len)) throw runtime_error();
+        return Util::Bint(s);
+    }
+};
+}
+
+const int N = 1e5;
+
+struct Point {
+    int x;
+    double y;
+    bool operator==(const Point &rhs) const { return x == rhs.x && y == rhs.y; }
+};
+
+template<typename T>
+bool equal(const std::list<T> &x, const sjtu::list<T> &y) {
+    if (x.size() != y.size())
+        return false;
+    typename std::list<T>::const_iterator itx = x.cbegin();
+    typename sjtu::list<T>::const_iterator ity = y.cbegin();
+    for (; itx != x.cend() && ity != y.cend(); ++itx, ++ity)
+        if (!(*itx == *ity))
+            return false;
+    return ity == y.cend();
+}
+
+bool testRoundTrip() {
+    const size_t chunk = 65536 / sizeof(int);
+    const size_t sizes[] = {0, 1, chunk - 1, chunk, chunk + 1, 3 * chunk + 5};
+    for (size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); ++k) {
+        std::list<int> ans;
+        sjtu::list<int> myList, other;
+        for (size_t i = 0; i < sizes[k]; ++i) {
+            int x = rand();
+            ans.push_back(x);
+            myList.push_back(x);
+        }
+        other.push_back(-1);
+        std::stringstream ss;
+        myList.save(ss);
+        other.load(ss);
+        if (!equal(ans, other) || !equal(ans, myList))
+            return false;
+    }
+    return true;
+}
+
+bool testStruct() {
+    std::list<Point> ans;
+    sjtu::list<Point> myList, other;
+    for (int i = 0; i < N; ++i) {
+        Point p = {rand(), rand() / 7.0};
+        ans.push_back(p);
+        myList.push_back(p);
+    }
+    std::stringstream ss;
+    myList.save(ss);
+    other.load(ss);
+    if (!equal(ans, other))
+        return false;
+    other.push_front(ans.back());
+    other.pop_back();
+    ans.push_front(ans.back());
+    ans.pop_back();
+    return equal(ans, other);
+}
+
+bool testBint() {
+    std::list<Util::Bint> ans;
+    sjtu::list<Util::Bint> myList, other;
+    for (int i = 0; i < 2000; ++i) {
+        Util::Bint y = Util::Bint(rand()) * Util::Bint(rand()) * Util::Bint(rand());
+        Util::Bint x = i % 3 ? y : -y;
+        ans.push_back(x);
+        myList.push_back(x);
+    }
+    std::stringstream ss;
+    myList.save(ss);
+    other.load(ss);
+    return equal(ans, other);
+}
+
+bool testTruncated() {
+    sjtu::list<int> myList, other;
+    for (int i = 0; i < N; ++i)
+        myList.push_back(i);
+    std::stringstream ss;
+    myList.save(ss);
+    std::string bytes = ss.str();
+    const size_t cuts[] = {0, 4, 8, 100, bytes.size() - 1};
+    for (size_t k = 0; k < sizeof(cuts) / sizeof(cuts[0]); ++k) {
+        std::istringstream in(bytes.substr(0, cuts[k]));
+        other.push_back(1);
+        try {
+            other.load(in);
+            return false;
+        } catch (sjtu::runtime_error) {
+            if (!other.empty())
+                return false;
+        }
+    }
+    return true;
+}
+
+bool testCorrupt() {
+    unsigned long long n = ~0ull / 2;
+    std::string bytes(reinterpret_cast<const char *>(&n), sizeof(n));
+    bytes += std::string(64, 'x');
+    sjtu::list<int> myList;
+    std::istringstream in(bytes);
+    try {
+        myList.load(in);
+    } catch (sjtu::runtime_error) {
+        return myList.empty();
+    }
+    return false;
+}
+
+int main() {
+    srand(2653);
+    bool (*testList[])() = {
+            testRoundTrip, testStruct, testBint, testTruncated, testCorrupt
+    };
+    const char* Messages[] = {
+            "Test 1: Testing save() & load() around the chunk size...",
+            "Test 2: Testing trivially copyable structs...",
+            "Test 3: Testing class-bint with an element_codec...",
+            "Test 4: Testing truncated streams...",
+            "Test 5: Testing a corrupted size..."
+    };
+
+    bool okay = true;
+    for (int i = 0; i < sizeof(testList) / sizeof(testList[0]); ++i) {
+        printf("%s", Messages[i]);
+        if (testList[i]()){
+            printf("Passed\n");
+        } else {
+            okay = false;
+            printf("Failed\n");
+        }
+    }
+
+    if (okay)
+        printf("Congratulations, you have passed all tests!\n");
+    else printf("Unfortunately, you failed in some of the tests.\n");
+    return 0;
+}
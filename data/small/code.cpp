@@ -0,0 +1,243 @@
+#include "class-bint.hpp"
+#include "small_list.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <vector>
+
+const int N = 2e4;
+
+template<typename T>
+bool equal(const std::list<T> &x, const sjtu::list<T> &y) {
+    if (x.size() != y.size())
+        return false;
+    typename std::list<T>::const_iterator itx = x.cbegin();
+    typename sjtu::list<T>::const_iterator ity = y.cbegin();
+    for (; itx != x.cend() && ity != y.cend(); ++itx, ++ity)
+        if (!(*itx == *ity))
+            return false;
+    return ity == y.cend();
+}
+
+bool testBuffer() {
+    sjtu::small_list<int, 8> s;
+    if (s.inline_available() != 8)
+        return false;
+    for (int i = 0; i < 5; ++i)
+        s.push_back(i);
+    if (s.inline_available() != 3 || s.size() != 5)
+        return false;
+    for (int i = 5; i < 20; ++i)
+        s.push_back(i);
+    if (s.inline_available() != 0)
+        return false;
+    s.pop_front();
+    s.pop_front();
+    if (s.inline_available() != 2 || s.size() != 18)
+        return false;
+    s.clear();
+    return s.inline_available() == 8 && s.empty();
+}
+
+bool testRandomOps() {
+    std::list<int> ans;
+    sjtu::small_list<int, 16> s;
+    for (int i = 0; i < N; ++i) {
+        int op = rand() % 6, x = rand();
+        if (op == 0 || op == 1) {
+            ans.push_back(x);
+            s.push_back(x);
+        } else if (op == 2) {
+            ans.push_front(x);
+            s.push_front(x);
+        } else if (op == 3 && !ans.empty()) {
+            ans.pop_back();
+            s.pop_back();
+        } else if (op == 4 && !ans.empty()) {
+            ans.pop_front();
+            s.pop_front();
+        } else if (op == 5) {
+            size_t k = rand() % (ans.size() + 1);
+            std::list<int>::iterator a = ans.begin();
+            sjtu::list<int>::iterator b = s.begin();
+            for (size_t j = 0; j < k; ++j, ++a, ++b);
+            ans.insert(a, x);
+            s.insert(b, x);
+        }
+        if (ans.size() > 40 && rand() % 4 == 0) {
+            while (ans.size() > 3) {
+                ans.pop_back();
+                s.pop_back();
+            }
+        }
+    }
+    return equal(ans, s);
+}
+
+bool testCopy() {
+    std::list<int> ans;
+    sjtu::small_list<int, 4> s;
+    for (int i = 0; i < 10; ++i) {
+        ans.push_back(i * 7);
+        s.push_back(i * 7);
+    }
+    sjtu::small_list<int, 4> t(s);
+    if (!equal(ans, t) || t.inline_available() != 0)
+        return false;
+    sjtu::list<int> plain;
+    plain.push_back(1);
+    sjtu::small_list<int, 4> u(plain);
+    if (u.size() != 1 || u.front() != 1 || u.inline_available() != 3)
+        return false;
+    u = s;
+    t.clear();
+    t = plain;
+    return equal(ans, u) && equal(ans, s) && t.size() == 1 && t.back() == 1;
+}
+
+bool testHandOver() {
+    std::list<int> a, b;
+    sjtu::small_list<int, 8> s;
+    sjtu::list<int> l;
+    for (int i = 0; i < 12; ++i) {
+        a.push_back(i * 2);
+        s.push_back(i * 2);
+        b.push_back(i * 2 + 1);
+        l.push_back(i * 2 + 1);
+    }
+    l.merge(s);
+    a.merge(b);
+    if (!equal(a, l) || !s.empty() || s.inline_available() != 8)
+        return false;
+    for (int i = 0; i < 6; ++i)
+        s.push_back(100 + i);
+    sjtu::list<int>::node_handle nh = s.extract(++s.begin());
+    if (s.size() != 5 || nh.value() != 101 || s.inline_available() != 3)
+        return false;
+    l.insert(l.begin(), static_cast<sjtu::list<int>::node_handle &&>(nh));
+    s.clear();
+    return l.size() == 25 && l.front() == 101 && nh.empty();
+}
+
+bool testOperations() {
+    std::list<int> ans;
+    sjtu::small_list<int, 8> s;
+    for (int i = 0; i < 1000; ++i) {
+        int x = rand() % 50;
+        ans.push_back(x);
+        s.push_back(x);
+    }
+    ans.sort();
+    s.sort();
+    if (!equal(ans, s))
+        return false;
+    ans.unique();
+    s.unique();
+    if (!equal(ans, s))
+        return false;
+    ans.reverse();
+    s.reverse();
+    return equal(ans, s);
+}
+
+int budget = -1; // copies left before Fragile throws, -1 for no limit
+
+class Fragile {
+public:
+    int val;
+    Fragile(int v): val(v) {}
+    Fragile(const Fragile &other): val(other.val) {
+        if (budget == 0) throw 1;
+        if (budget > 0) --budget;
+    }
+    bool operator==(const Fragile &rhs) const { return val == rhs.val; }
+};
+
+bool testConstructors() {
+    sjtu::small_list<int> s(5, 1);
+    std::list<int> ans(5, 1);
+    if (!equal(ans, s) || s.inline_available() != 3)
+        return false;
+    sjtu::small_list<int, 4> t(10, 2);
+    std::list<int> ans2(10, 2);
+    if (!equal(ans2, t) || t.inline_available() != 0)
+        return false;
+    std::vector<int> v;
+    for (int i = 0; i < 30; ++i)
+        v.push_back(rand());
+    std::list<int> ans3(v.begin(), v.end());
+    sjtu::small_list<int, 16> u(v.begin(), v.end());
+    sjtu::small_list<int, 16> w(v.begin(), v.begin() + 3);
+    if (!equal(ans3, u) || u.inline_available() != 0 || w.size() != 3 || w.inline_available() != 13)
+        return false;
+    sjtu::small_list<int> e(v.begin(), v.begin());
+    if (!e.empty() || e.inline_available() != 8)
+        return false;
+    std::vector<Fragile> f;
+    for (int i = 0; i < 20; ++i)
+        f.push_back(Fragile(i));
+    for (int b = 0; b < 20; b += 3) {
+        budget = b;
+        try {
+            sjtu::small_list<Fragile, 8> g(f.begin(), f.end());
+            budget = -1;
+            return false;
+        } catch (int) {}
+        budget = b;
+        try {
+            sjtu::small_list<Fragile, 8> g(20, f[0]);
+            budget = -1;
+            return false;
+        } catch (int) {}
+    }
+    budget = -1;
+    return true;
+}
+
+bool testBint() {
+    std::list<Util::Bint> ans;
+    sjtu::small_list<Util::Bint, 4> s;
+    for (int i = 0; i < 200; ++i) {
+        Util::Bint x = Util::Bint(rand()) * Util::Bint(rand());
+        ans.push_back(x);
+        s.push_back(x);
+    }
+    for (int i = 0; i < 150; ++i) {
+        ans.pop_front();
+        s.pop_front();
+    }
+    return equal(ans, s) && s.inline_available() == 4;
+}
+
+int main() {
+    srand(2653);
+    bool (*testList[])() = {
+            testBuffer, testRandomOps, testCopy, testHandOver, testOperations, testConstructors, testBint
+    };
+    const char* Messages[] = {
+            "Test 1: Testing the inline buffer...",
+            "Test 2: Testing random push / pop / insert...",
+            "Test 3: Testing copy constructors and operator=...",
+            "Test 4: Testing merge() and extract() into a plain list...",
+            "Test 5: Testing sort(), unique() and reverse()...",
+            "Test 6: Testing the range and fill constructors...",
+            "Test 7: Testing class-bint..."
+    };
+
+    bool okay = true;
+    for (int i = 0; i < sizeof(testList) / sizeof(testList[0]); ++i) {
+        printf("%s", Messages[i]);
+        if (testList[i]()){
+            printf("Passed\n");
+        } else {
+            okay = false;
+            printf("Failed\n");
+        }
+    }
+
+    if (okay)
+        printf("Congratulations, you have passed all tests!\n");
+    else printf("Unfortunately, you failed in some of the tests.\n");
+    return 0;
+}
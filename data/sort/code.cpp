@@ -0,0 +1,166 @@
+#include "class-bint.hpp"
+#include "list.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+const int N = 1e5;
+
+long long comparisons = 0;
+long long throwAt = -1; // comparison count at which Record throws, -1 for never
+
+/**
+ * compared by key only, id records the original position; not trivial, so sort() relinks the nodes
+ */
+class Record {
+public:
+    int key, id;
+    Record(int k, int i): key(k), id(i) {}
+    Record(const Record &other): key(other.key), id(other.id) {}
+    bool operator<(const Record &rhs) const {
+        if (++comparisons == throwAt) throw 1;
+        return key < rhs.key;
+    }
+    bool operator==(const Record &rhs) const { return key == rhs.key && id == rhs.id; }
+};
+
+template<typename T>
+bool equal(const std::vector<T> &x, const sjtu::list<T> &y) {
+    if (x.size() != y.size())
+        return false;
+    typename sjtu::list<T>::const_iterator ity = y.cbegin();
+    for (size_t i = 0; i < x.size(); ++i, ++ity)
+        if (!(x[i] == *ity))
+            return false;
+    return ity == y.cend();
+}
+
+/**
+ * fill both containers with n records whose keys follow pattern
+ */
+void build(int pattern, int n, std::vector<Record> &ans, sjtu::list<Record> &myList) {
+    ans.clear();
+    myList.clear();
+    for (int i = 0; i < n; ++i) {
+        int key;
+        if (pattern == 0) key = rand();
+        else if (pattern == 1) key = i / 3;
+        else if (pattern == 2) key = (n - i) / 3;
+        else if (pattern == 3) key = i % 1000;
+        else if (pattern == 4) key = rand() % 5;
+        else key = i % 97 == 0 ? rand() : i;
+        ans.push_back(Record(key, i));
+        myList.push_back(Record(key, i));
+    }
+}
+
+bool testStability() {
+    std::vector<Record> ans;
+    sjtu::list<Record> myList;
+    for (int pattern = 0; pattern < 6; ++pattern) {
+        build(pattern, N, ans, myList);
+        std::stable_sort(ans.begin(), ans.end());
+        myList.sort();
+        if (!equal(ans, myList))
+            return false;
+    }
+    return true;
+}
+
+bool testSizes() {
+    std::vector<Record> ans;
+    sjtu::list<Record> myList;
+    for (int n = 0; n < 300; ++n) {
+        build(n % 6, n, ans, myList);
+        std::stable_sort(ans.begin(), ans.end());
+        myList.sort();
+        if (!equal(ans, myList))
+            return false;
+    }
+    return true;
+}
+
+bool testRuns() {
+    std::vector<Record> ans;
+    sjtu::list<Record> myList;
+    build(1, N, ans, myList);
+    comparisons = 0;
+    myList.sort();
+    if (comparisons > 2 * N || !equal(ans, myList))
+        return false;
+    ans.clear();
+    myList.clear();
+    for (int i = 0; i < N; ++i) {
+        ans.push_back(Record(N - i, i));
+        myList.push_back(Record(N - i, i));
+    }
+    std::stable_sort(ans.begin(), ans.end());
+    comparisons = 0;
+    myList.sort();
+    return comparisons <= 2 * N && equal(ans, myList);
+}
+
+bool testBint() {
+    std::vector<Util::Bint> ans;
+    sjtu::list<Util::Bint> myList;
+    for (int i = 0; i < 5000; ++i) {
+        Util::Bint x = Util::Bint(rand()) * Util::Bint(rand() % 100);
+        ans.push_back(x);
+        myList.push_back(x);
+    }
+    std::stable_sort(ans.begin(), ans.end());
+    myList.sort();
+    return equal(ans, myList);
+}
+
+bool testException() {
+    std::vector<Record> ans;
+    sjtu::list<Record> myList;
+    build(0, 10000, ans, myList);
+    comparisons = 0;
+    throwAt = 50000;
+    try {
+        myList.sort();
+    } catch (int) {
+        throwAt = -1;
+        if (!equal(ans, myList))
+            return false;
+        std::stable_sort(ans.begin(), ans.end());
+        myList.sort();
+        return equal(ans, myList);
+    }
+    throwAt = -1;
+    return false;
+}
+
+int main() {
+    srand(2653);
+    bool (*testList[])() = {
+            testStability, testSizes, testRuns, testBint, testException
+    };
+    const char* Messages[] = {
+            "Test 1: Testing stability of sort() on several patterns...",
+            "Test 2: Testing short lists...",
+            "Test 3: Testing sorted and reversed input...",
+            "Test 4: Testing class-bint...",
+            "Test 5: Testing exception safety..."
+    };
+
+    bool okay = true;
+    for (int i = 0; i < sizeof(testList) / sizeof(testList[0]); ++i) {
+        printf("%s", Messages[i]);
+        if (testList[i]()){
+            printf("Passed\n");
+        } else {
+            okay = false;
+            printf("Failed\n");
+        }
+    }
+
+    if (okay)
+        printf("Congratulations, you have passed all tests!\n");
+    else printf("Unfortunately, you failed in some of the tests.\n");
+    return 0;
+}
@@ -0,0 +1,176 @@
+#include "class-bint.hpp"
+#include "list.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+const int N = 5e4;
+
+template<typename T>
+bool equal(const std::vector<T> &x, const sjtu::list<T> &y) {
+    if (x.size() != y.size())
+        return false;
+    typename sjtu::list<T>::const_iterator ity = y.cbegin();
+    for (size_t i = 0; i < x.size(); ++i, ++ity)
+        if (!(x[i] == *ity))
+            return false;
+    return ity == y.cend();
+}
+
+int keyCalls = 0, copies = 0;
+
+std::string randomString() {
+    std::string s(1 + rand() % 12, 'a');
+    for (size_t i = 0; i < s.size(); ++i)
+        s[i] = 'a' + rand() % 26;
+    return s;
+}
+
+bool shorter(const std::string &a, const std::string &b) { return a.size() < b.size(); }
+
+struct Length {
+    size_t operator()(const std::string &s) const {
+        ++keyCalls;
+        return s.size();
+    }
+};
+
+class Counted {
+public:
+    int val;
+    explicit Counted(int v): val(v) {}
+    Counted(const Counted &other): val(other.val) { ++copies; }
+    bool operator==(const Counted &rhs) const { return val == rhs.val; }
+};
+
+bool testLength() {
+    std::vector<std::string> ans;
+    sjtu::list<std::string> myList;
+    for (int i = 0; i < N; ++i) {
+        std::string s = randomString();
+        ans.push_back(s);
+        myList.push_back(s);
+    }
+    std::stable_sort(ans.begin(), ans.end(), shorter);
+    keyCalls = 0;
+    myList.sort_by_key(Length());
+    return keyCalls == N && equal(ans, myList);
+}
+
+bool testStringKey() {
+    std::vector<std::string> ans;
+    sjtu::list<std::string> myList;
+    for (int i = 0; i < N; ++i) {
+        std::string s = randomString();
+        ans.push_back(s);
+        myList.push_back(s);
+    }
+    // by the reversed string: a key of a type with an expensive operator<
+    std::vector<std::pair<std::string, size_t> > order;
+    for (size_t i = 0; i < ans.size(); ++i)
+        order.push_back(std::make_pair(std::string(ans[i].rbegin(), ans[i].rend()), i));
+    std::stable_sort(order.begin(), order.end());
+    std::vector<std::string> sorted;
+    for (size_t i = 0; i < order.size(); ++i)
+        sorted.push_back(ans[order[i].second]);
+    myList.sort_by_key([](const std::string &s) { return std::string(s.rbegin(), s.rend()); });
+    return equal(sorted, myList);
+}
+
+bool testNoCopy() {
+    sjtu::list<Counted> myList;
+    std::vector<Counted> ans;
+    for (int i = 0; i < 1000; ++i) {
+        myList.push_back(Counted(rand() % 100));
+        ans.push_back(myList.back());
+    }
+    std::vector<std::pair<int, size_t> > order;
+    for (size_t i = 0; i < ans.size(); ++i)
+        order.push_back(std::make_pair(-ans[i].val, i));
+    std::stable_sort(order.begin(), order.end());
+    std::vector<Counted> sorted;
+    for (size_t i = 0; i < order.size(); ++i)
+        sorted.push_back(ans[order[i].second]);
+    copies = 0;
+    myList.sort_by_key([](const Counted &c) { return -c.val; });
+    return copies == 0 && equal(sorted, myList);
+}
+
+bool testBint() {
+    std::vector<Util::Bint> ans;
+    sjtu::list<Util::Bint> myList;
+    std::vector<std::pair<size_t, size_t> > order;
+    for (int i = 0; i < 2000; ++i) {
+        Util::Bint x = Util::Bint(rand()) * Util::Bint(rand() % 1000);
+        ans.push_back(x);
+        myList.push_back(x);
+        std::ostringstream os;
+        os << x;
+        order.push_back(std::make_pair(os.str().size(), (size_t)i));
+    }
+    std::stable_sort(order.begin(), order.end());
+    std::vector<Util::Bint> sorted;
+    for (size_t i = 0; i < order.size(); ++i)
+        sorted.push_back(ans[order[i].second]);
+    myList.sort_by_key([](const Util::Bint &x) {
+        std::ostringstream os;
+        os << x;
+        return os.str().size();
+    });
+    return equal(sorted, myList);
+}
+
+bool testException() {
+    std::vector<std::string> ans;
+    sjtu::list<std::string> myList;
+    for (int i = 0; i < 1000; ++i) {
+        std::string s = randomString();
+        ans.push_back(s);
+        myList.push_back(s);
+    }
+    int calls = 0;
+    try {
+        myList.sort_by_key([&calls](const std::string &s) {
+            if (++calls == 700) throw 1;
+            return s;
+        });
+    } catch (int) {
+        return equal(ans, myList);
+    }
+    return false;
+}
+
+int main() {
+    srand(2653);
+    bool (*testList[])() = {
+            testLength, testStringKey, testNoCopy, testBint, testException
+    };
+    const char* Messages[] = {
+            "Test 1: Testing stability of sort_by_key()...",
+            "Test 2: Testing keys of type std::string...",
+            "Test 3: Testing that no element is copied...",
+            "Test 4: Testing class-bint...",
+            "Test 5: Testing exception safety..."
+    };
+
+    bool okay = true;
+    for (int i = 0; i < sizeof(testList) / sizeof(testList[0]); ++i) {
+        printf("%s", Messages[i]);
+        if (testList[i]()){
+            printf("Passed\n");
+        } else {
+            okay = false;
+            printf("Failed\n");
+        }
+    }
+
+    if (okay)
+        printf("Congratulations, you have passed all tests!\n");
+    else printf("Unfortunately, you failed in some of the tests.\n");
+    return 0;
+}
@@ -0,0 +1,155 @@
+#include "list.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+const int N = 1e5;
+
+bool armed = false; // comparing a Pair with key -1 throws while set
+
+/**
+ * small and trivial: sort() works on a buffer of copies
+ */
+struct Pair {
+    int key, id;
+    bool operator<(const Pair &rhs) const {
+        if (armed && (key == -1 || rhs.key == -1)) throw 1;
+        return key < rhs.key;
+    }
+    bool operator==(const Pair &rhs) const { return key == rhs.key && id == rhs.id; }
+};
+
+/**
+ * trivial but too large for the buffer, sorted by relinking
+ */
+struct Wide {
+    int key, id, pad[6];
+    bool operator<(const Wide &rhs) const { return key < rhs.key; }
+    bool operator==(const Wide &rhs) const { return key == rhs.key && id == rhs.id; }
+};
+
+template<typename T>
+bool equal(const std::vector<T> &x, const sjtu::list<T> &y) {
+    if (x.size() != y.size())
+        return false;
+    typename sjtu::list<T>::const_iterator ity = y.cbegin();
+    for (size_t i = 0; i < x.size(); ++i, ++ity)
+        if (!(x[i] == *ity))
+            return false;
+    return ity == y.cend();
+}
+
+bool testStability() {
+    const int ranges[] = {2, 100, N * 10};
+    for (int k = 0; k < 3; ++k) {
+        std::vector<Pair> ans;
+        sjtu::list<Pair> myList;
+        for (int i = 0; i < N; ++i) {
+            Pair p = {rand() % ranges[k], i};
+            ans.push_back(p);
+            myList.push_back(p);
+        }
+        std::stable_sort(ans.begin(), ans.end());
+        myList.sort();
+        if (!equal(ans, myList))
+            return false;
+    }
+    return true;
+}
+
+bool testFloating() {
+    std::vector<double> ans;
+    sjtu::list<double> myList;
+    std::vector<float> ansFloat;
+    sjtu::list<float> floatList;
+    for (int i = 0; i < N; ++i) {
+        double x = (rand() - RAND_MAX / 2) / 3.0;
+        ans.push_back(x);
+        myList.push_back(x);
+        ansFloat.push_back((float)x);
+        floatList.push_back((float)x);
+    }
+    std::sort(ans.begin(), ans.end());
+    std::sort(ansFloat.begin(), ansFloat.end());
+    myList.sort();
+    floatList.sort();
+    return equal(ans, myList) && equal(ansFloat, floatList);
+}
+
+bool testNodesStay() {
+    sjtu::list<Pair> myList;
+    for (int i = 0; i < 1000; ++i) {
+        Pair p = {1000 - i, i};
+        myList.push_back(p);
+    }
+    sjtu::list<Pair>::iterator first = myList.begin(), last = --myList.end();
+    myList.sort();
+    if (first != myList.begin() || first->key != 1 || last->key != 1000)
+        return false;
+    ++first;
+    return first->key == 2 && (--last)->key == 999;
+}
+
+bool testWide() {
+    std::vector<Wide> ans;
+    sjtu::list<Wide> myList;
+    for (int i = 0; i < N; ++i) {
+        Wide w = {rand() % 50, i, {0, 0, 0, 0, 0, 0}};
+        ans.push_back(w);
+        myList.push_back(w);
+    }
+    std::stable_sort(ans.begin(), ans.end());
+    myList.sort();
+    return equal(ans, myList);
+}
+
+bool testException() {
+    std::vector<Pair> ans;
+    sjtu::list<Pair> myList;
+    for (int i = 0; i < 10000; ++i) {
+        Pair p = {i == 5000 ? -1 : rand(), i};
+        ans.push_back(p);
+        myList.push_back(p);
+    }
+    armed = true;
+    try {
+        myList.sort();
+    } catch (int) {
+        armed = false;
+        return equal(ans, myList);
+    }
+    armed = false;
+    return false;
+}
+
+int main() {
+    srand(2653);
+    bool (*testList[])() = {
+            testStability, testFloating, testNodesStay, testWide, testException
+    };
+    const char* Messages[] = {
+            "Test 1: Testing stability of sort() on small trivial types...",
+            "Test 2: Testing float & double...",
+            "Test 3: Testing that nodes keep their places...",
+            "Test 4: Testing large trivial types...",
+            "Test 5: Testing exception safety..."
+    };
+
+    bool okay = true;
+    for (int i = 0; i < sizeof(testList) / sizeof(testList[0]); ++i) {
+        printf("%s", Messages[i]);
+        if (testList[i]()){
+            printf("Passed\n");
+        } else {
+            okay = false;
+            printf("Failed\n");
+        }
+    }
+
+    if (okay)
+        printf("Congratulations, you have passed all tests!\n");
+    else printf("Unfortunately, you failed in some of the tests.\n");
+    return 0;
+}
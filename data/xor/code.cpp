@@ -0,0 +1,214 @@
+#include "class-bint.hpp"
+#include "xor_list.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+
+const int N = 5e4;
+
+template<typename T>
+bool equal(const std::list<T> &x, const sjtu::xor_list<T> &y) {
+    if (x.size() != y.size())
+        return false;
+    typename std::list<T>::const_iterator itx = x.cbegin();
+    typename sjtu::xor_list<T>::const_iterator ity = y.cbegin();
+    for (; itx != x.cend() && ity != y.cend(); ++itx, ++ity)
+        if (!(*itx == *ity))
+            return false;
+    return ity == y.cend();
+}
+
+/**
+ * walk y backwards from end()
+ */
+template<typename T>
+bool equalBackwards(const std::list<T> &x, const sjtu::xor_list<T> &y) {
+    if (x.size() != y.size())
+        return false;
+    typename std::list<T>::const_reverse_iterator itx = x.crbegin();
+    typename sjtu::xor_list<T>::const_iterator ity = y.cend();
+    for (; itx != x.crend(); ++itx)
+        if (!(*itx == *--ity))
+            return false;
+    return ity == y.cbegin();
+}
+
+template<typename T>
+void randomOps(std::list<T> &ans, sjtu::xor_list<T> &myList, int ops) {
+    for (int i = 0; i < ops; ++i) {
+        int op = rand() % 6;
+        T x = T(rand());
+        if (op == 0 || op == 1) {
+            ans.push_back(x);
+            myList.push_back(x);
+        } else if (op == 2) {
+            ans.push_front(x);
+            myList.push_front(x);
+        } else if (op == 3 && !ans.empty()) {
+            ans.pop_back();
+            myList.pop_back();
+        } else if (op == 4 && !ans.empty()) {
+            ans.pop_front();
+            myList.pop_front();
+        } else if (op == 5) {
+            size_t k = rand() % (ans.size() + 1);
+            typename std::list<T>::iterator a = ans.begin();
+            typename sjtu::xor_list<T>::iterator b = myList.begin();
+            for (size_t j = 0; j < k && j < 100; ++j, ++a, ++b);
+            if (a != ans.end() && rand() % 2) {
+                ans.erase(a);
+                myList.erase(b);
+            } else {
+                ans.insert(a, x);
+                myList.insert(b, x);
+            }
+        }
+    }
+}
+
+bool testRandomOps() {
+    std::list<int> ans;
+    sjtu::xor_list<int> myList;
+    randomOps(ans, myList, N * 4);
+    return equal(ans, myList) && equalBackwards(ans, myList);
+}
+
+bool testInsertErase() {
+    std::list<int> ans;
+    sjtu::xor_list<int> myList;
+    for (int i = 0; i < 1000; ++i) {
+        ans.push_back(i);
+        myList.push_back(i);
+    }
+    // the iterators returned by insert / erase stay usable for walking on
+    std::list<int>::iterator a = ans.begin();
+    sjtu::xor_list<int>::iterator b = myList.begin();
+    while (a != ans.end()) {
+        if (*a % 3 == 0) {
+            a = ans.erase(a);
+            b = myList.erase(b);
+        } else {
+            a = ans.insert(a, -*a);
+            b = myList.insert(b, -*b);
+            ++a, ++a;
+            ++b, ++b;
+        }
+    }
+    if (b != myList.end())
+        return false;
+    --b;
+    return *b == ans.back() && equal(ans, myList) && equalBackwards(ans, myList);
+}
+
+bool testReverse() {
+    std::list<int> ans;
+    sjtu::xor_list<int> myList;
+    randomOps(ans, myList, N);
+    ans.reverse();
+    myList.reverse();
+    if (!equal(ans, myList))
+        return false;
+    randomOps(ans, myList, N);
+    ans.reverse();
+    myList.reverse();
+    return equal(ans, myList) && equalBackwards(ans, myList);
+}
+
+bool testCopy() {
+    std::list<int> ans;
+    sjtu::xor_list<int> myList;
+    randomOps(ans, myList, N);
+    myList.reverse();
+    ans.reverse();
+    sjtu::xor_list<int> other(myList), third;
+    third.push_back(1);
+    third = other;
+    third = third;
+    other.clear();
+    return equal(ans, third) && equal(ans, myList) && other.empty();
+}
+
+bool testBint() {
+    std::list<Util::Bint> ans;
+    sjtu::xor_list<Util::Bint> myList;
+    for (int i = 0; i < 1000; ++i) {
+        Util::Bint x = Util::Bint(rand()) * Util::Bint(rand());
+        ans.push_front(x);
+        myList.push_front(x);
+    }
+    for (int i = 0; i < 300; ++i) {
+        ans.pop_back();
+        myList.pop_back();
+    }
+    return equal(ans, myList);
+}
+
+bool testException() {
+    sjtu::xor_list<int> myList, other;
+    int caught = 0;
+    try {
+        myList.pop_front();
+    } catch (sjtu::container_is_empty) {
+        ++caught;
+    }
+    try {
+        myList.front();
+    } catch (sjtu::container_is_empty) {
+        ++caught;
+    }
+    myList.push_back(1);
+    other.push_back(2);
+    try {
+        myList.insert(other.begin(), 3);
+    } catch (sjtu::invalid_iterator) {
+        ++caught;
+    }
+    try {
+        myList.erase(myList.end());
+    } catch (sjtu::invalid_iterator) {
+        ++caught;
+    }
+    try {
+        --myList.begin();
+    } catch (sjtu::invalid_iterator) {
+        ++caught;
+    }
+    try {
+        ++myList.end();
+    } catch (sjtu::invalid_iterator) {
+        ++caught;
+    }
+    return caught == 6 && myList.size() == 1 && myList.back() == 1 && other.front() == 2;
+}
+
+int main() {
+    srand(2653);
+    bool (*testList[])() = {
+            testRandomOps, testInsertErase, testReverse, testCopy, testBint, testException
+    };
+    const char* Messages[] = {
+            "Test 1: Testing random push / pop / insert / erase...",
+            "Test 2: Testing iterators returned by insert() & erase()...",
+            "Test 3: Testing reverse()...",
+            "Test 4: Testing copy constructor and operator=...",
+            "Test 5: Testing class-bint...",
+            "Test 6: Testing exception throw..."
+    };
+
+    bool okay = true;
+    for (int i = 0; i < sizeof(testList) / sizeof(testList[0]); ++i) {
+        printf("%s", Messages[i]);
+        if (testList[i]()){
+            printf("Passed\n");
+        } else {
+            okay = false;
+            printf("Failed\n");
+        }
+    }
+
+    if (okay)
+        printf("Congratulations, you have passed all tests!\n");
+    else printf("Unfortunately, you failed in some of the tests.\n");
+    return 0;
+}
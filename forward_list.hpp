@@ -0,0 +1,329 @@
+#ifndef SJTU_FORWARD_LIST_HPP
+#define SJTU_FORWARD_LIST_HPP
+
+#include "exceptions.hpp"
+
+#include <cstddef>
+
+namespace sjtu {
+/**
+ * a singly-linked list like std::forward_list: one link per node, the value stored in the node itself.
+ * positions are addressed by the element before them (insert_after / erase_after),
+ * starting from before_begin(); iterators only move forward.
+ * size() is kept, so it is O(1).
+ */
+template<typename T>
+class forward_list {
+protected:
+    struct link {
+        link *next;
+        link(): next(nullptr) {}
+    };
+    struct node : link {
+        T val;
+        explicit node(const T &value): link(), val(value) {}
+    };
+
+    link head; // before_begin(), holds no value
+    size_t sz;
+
+    static T &value(link *cur) { return static_cast<node *>(cur)->val; }
+    static void destroy_chain(link *cur) {
+        while (cur) {
+            link *n = cur->next;
+            delete static_cast<node *>(cur);
+            cur = n;
+        }
+    }
+    /**
+     * merge the sorted null-terminated chain b into the sorted chain a, keeping a first among equivalents.
+     * if a comparison throws, a holds every node of both chains (in no particular order) before rethrowing
+     */
+    static void merge_into(link *&a, link *b) {
+        link first;
+        link *t = &first, *x = a;
+        try {
+            while (x && b) {
+                if (value(b) < value(x)) {
+                    t->next = b;
+                    b = b->next;
+                } else {
+                    t->next = x;
+                    x = x->next;
+                }
+                t = t->next;
+            }
+        } catch (...) {
+            t->next = x;
+            while (t->next) t = t->next;
+            t->next = b;
+            a = first.next;
+            throw;
+        }
+        t->next = x ? x : b;
+        a = first.next;
+    }
+    void append(const forward_list &other) {
+        link *last = &head;
+        while (last->next) last = last->next;
+        for (link *p = other.head.next; p; p = p->next) {
+            last->next = new node(static_cast<node *>(p)->val);
+            last = last->next;
+            ++sz;
+        }
+    }
+
+public:
+    class const_iterator;
+    class iterator {
+    private:
+        link *cur;
+        const forward_list<T> *owner;
+    public:
+        iterator(): cur(nullptr), owner(nullptr) {}
+        iterator(const forward_list<T> *o, link *c): cur(c), owner(o) {}
+        iterator operator++(int) {
+            iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+        iterator & operator++() {
+            if (owner == nullptr || cur == nullptr) throw invalid_iterator();
+            cur = cur->next;
+            return *this;
+        }
+        /**
+         * throw for end() and before_begin()
+         */
+        T & operator *() const {
+            if (owner == nullptr || cur == nullptr || cur == &owner->head) throw invalid_iterator();
+            return value(cur);
+        }
+        T * operator ->() const {
+            if (owner == nullptr || cur == nullptr || cur == &owner->head) throw invalid_iterator();
+            return &value(cur);
+        }
+        bool operator==(const iterator &rhs) const { return owner == rhs.owner && cur == rhs.cur; }
+        bool operator==(const const_iterator &rhs) const { return owner == rhs.owner && cur == rhs.cur; }
+        bool operator!=(const iterator &rhs) const { return !(*this == rhs); }
+        bool operator!=(const const_iterator &rhs) const { return !(*this == rhs); }
+
+        friend class forward_list<T>;
+    };
+    class const_iterator {
+    private:
+        const link *cur;
+        const forward_list<T> *owner;
+    public:
+        const_iterator(): cur(nullptr), owner(nullptr) {}
+        const_iterator(const forward_list<T> *o, const link *c): cur(c), owner(o) {}
+        const_iterator(const iterator &it): cur(it.cur), owner(it.owner) {}
+        const_iterator operator++(int) {
+            const_iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+        const_iterator & operator++() {
+            if (owner == nullptr || cur == nullptr) throw invalid_iterator();
+            cur = cur->next;
+            return *this;
+        }
+        const T & operator *() const {
+            if (owner == nullptr || cur == nullptr || cur == &owner->head) throw invalid_iterator();
+            return static_cast<const node *>(cur)->val;
+        }
+        const T * operator ->() const {
+            if (owner == nullptr || cur == nullptr || cur == &owner->head) throw invalid_iterator();
+            return &static_cast<const node *>(cur)->val;
+        }
+        bool operator==(const const_iterator &rhs) const { return owner == rhs.owner && cur == rhs.cur; }
+        bool operator==(const iterator &rhs) const { return owner == rhs.owner && cur == rhs.cur; }
+        bool operator!=(const const_iterator &rhs) const { return !(*this == rhs); }
+        bool operator!=(const iterator &rhs) const { return !(*this == rhs); }
+
+        friend class forward_list<T>;
+    };
+
+    forward_list(): head(), sz(0) {}
+    forward_list(const forward_list &other): head(), sz(0) {
+        try {
+            append(other);
+        } catch (...) {
+            clear();
+            throw;
+        }
+    }
+    ~forward_list() { clear(); }
+    forward_list &operator=(const forward_list &other) {
+        if (this == &other) return *this;
+        clear();
+        append(other);
+        return *this;
+    }
+
+    /**
+     * access the first element
+     * throw container_is_empty when the container is empty.
+     */
+    const T & front() const {
+        if (sz == 0) throw container_is_empty();
+        return static_cast<const node *>(head.next)->val;
+    }
+    /**
+     * the position before the first element, for insert_after / erase_after / splice_after
+     */
+    iterator before_begin() { return iterator(this, &head); }
+    const_iterator cbefore_begin() const { return const_iterator(this, &head); }
+    iterator begin() { return iterator(this, head.next); }
+    const_iterator cbegin() const { return const_iterator(this, head.next); }
+    iterator end() { return iterator(this, nullptr); }
+    const_iterator cend() const { return const_iterator(this, nullptr); }
+    bool empty() const { return sz == 0; }
+    size_t size() const { return sz; }
+
+    void clear() {
+        destroy_chain(head.next);
+        head.next = nullptr;
+        sz = 0;
+    }
+    /**
+     * insert value after pos (pos may be before_begin(), not end())
+     * return an iterator pointing to the inserted value
+     * throw if the iterator is invalid
+     */
+    iterator insert_after(iterator pos, const T &value) {
+        if (pos.owner != this || pos.cur == nullptr) throw invalid_iterator();
+        node *n = new node(value);
+        n->next = pos.cur->next;
+        pos.cur->next = n;
+        ++sz;
+        return iterator(this, n);
+    }
+    /**
+     * remove the element after pos
+     * returns an iterator pointing to the element after the removed one, end() if there is none
+     * throw if the container is empty, or pos is invalid or has no element after it
+     */
+    iterator erase_after(iterator pos) {
+        if (pos.owner != this || pos.cur == nullptr) throw invalid_iterator();
+        if (sz == 0) throw container_is_empty();
+        link *del = pos.cur->next;
+        if (del == nullptr) throw invalid_iterator();
+        pos.cur->next = del->next;
+        delete static_cast<node *>(del);
+        --sz;
+        return iterator(this, pos.cur->next);
+    }
+    void push_front(const T &value) { insert_after(before_begin(), value); }
+    /**
+     * throw when the container is empty.
+     */
+    void pop_front() {
+        if (sz == 0) throw container_is_empty();
+        erase_after(before_begin());
+    }
+    /**
+     * move every element of other after pos, in order; other becomes empty.
+     * no elements are copied or moved. O(size of other), to find its last node
+     * throw if pos is invalid
+     */
+    void splice_after(iterator pos, forward_list &other) {
+        if (pos.owner != this || pos.cur == nullptr) throw invalid_iterator();
+        if (this == &other || other.sz == 0) return;
+        link *last = other.head.next;
+        while (last->next) last = last->next;
+        last->next = pos.cur->next;
+        pos.cur->next = other.head.next;
+        sz += other.sz;
+        other.head.next = nullptr;
+        other.sz = 0;
+    }
+    /**
+     * move the element after it, from other (which may be *this), to after pos
+     * throw if an iterator is invalid or it has no element after it
+     */
+    void splice_after(iterator pos, forward_list &other, iterator it) {
+        if (pos.owner != this || pos.cur == nullptr) throw invalid_iterator();
+        if (it.owner != &other || it.cur == nullptr || it.cur->next == nullptr) throw invalid_iterator();
+        link *moved = it.cur->next;
+        if (pos.cur == it.cur || pos.cur == moved) return;
+        it.cur->next = moved->next;
+        moved->next = pos.cur->next;
+        pos.cur->next = moved;
+        --other.sz;
+        ++sz;
+    }
+    /**
+     * sort the values in ascending order with operator< of T
+     * stable bottom-up merge sort on the links: O(n log n), no extra memory, no elements copied or moved.
+     * if a comparison throws, every element is still in the list, in an unspecified order
+     */
+    void sort() {
+        if (sz <= 1) return;
+        link *bins[64] = {}; // bins[i] is empty or a sorted chain of 2^i elements, older than bins[i - 1]
+        int fill = 0;
+        link *rest = head.next;
+        try {
+            while (rest) {
+                link *carry = rest;
+                rest = rest->next;
+                carry->next = nullptr;
+                int i = 0;
+                for (; i < fill && bins[i]; ++i) {
+                    merge_into(bins[i], carry);
+                    carry = bins[i];
+                    bins[i] = nullptr;
+                }
+                bins[i] = carry;
+                if (i == fill) ++fill;
+            }
+            for (int i = 1; i < fill; ++i) {
+                link *later = bins[i - 1]; // leave each node in exactly one place for the catch below
+                bins[i - 1] = nullptr;
+                merge_into(bins[i], later);
+            }
+        } catch (...) {
+            link *all = rest;
+            for (int i = 0; i < fill; ++i) {
+                if (bins[i] == nullptr) continue;
+                link *last = bins[i];
+                while (last->next) last = last->next;
+                last->next = all;
+                all = bins[i];
+            }
+            head.next = all;
+            throw;
+        }
+        head.next = bins[fill - 1];
+    }
+    /**
+     * merge two sorted lists into one (both in ascending order), with operator< of T
+     * container other becomes empty; for equivalent elements, those from *this come first.
+     * no elements are copied or moved
+     */
+    void merge(forward_list &other) {
+        if (this == &other || other.sz == 0) return;
+        link *b = other.head.next;
+        other.head.next = nullptr;
+        sz += other.sz;
+        other.sz = 0;
+        merge_into(head.next, b);
+    }
+    /**
+     * reverse the order of the elements by relinking
+     */
+    void reverse() {
+        link *prev = nullptr, *cur = head.next;
+        while (cur) {
+            link *n = cur->next;
+            cur->next = prev;
+            prev = cur;
+            cur = n;
+        }
+        head.next = prev;
+    }
+};
+
+}
+
+#endif //SJTU_FORWARD_LIST_HPP
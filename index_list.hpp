@@ -0,0 +1,430 @@
+#ifndef SJTU_INDEX_LIST_HPP
+#define SJTU_INDEX_LIST_HPP
+
+#include "exceptions.hpp"
+
+#include <climits>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+namespace sjtu {
+/**
+ * a doubly-linked list whose links are 32-bit slot indices instead of pointers.
+ * values, next links and prev links are kept in three parallel arrays (structure of arrays),
+ * so a node costs sizeof(T) + 8 bytes instead of sizeof(T) + 24 bytes and a heap allocation,
+ * and a list built by push_back is traversed in address order.
+ * erased slots are chained on a free list and reused; the arrays double when full.
+ * iterators store slot indices, so they stay valid when the arrays grow (until their element is erased);
+ * references and pointers to elements do not.
+ * with Handles = true, handle_of() gives handles for references kept long term: a slot index and that slot's
+ * generation, which is bumped whenever the slot is freed, so a handle to an erased element is detected in O(1).
+ * the generations are a fourth array, so this costs 4 more bytes per slot; without Handles it is not allocated.
+ * holds at most UINT_MAX - 1 elements.
+ */
+template<typename T, bool Handles = false>
+class index_list {
+protected:
+    typedef unsigned int index_t;
+    static const index_t nil = UINT_MAX; // prev link of a free slot
+
+    T *vals; // slot 0 is the sentinel and holds no value
+    index_t *nxt; // also chains the free slots
+    index_t *prv;
+    index_t *gen; // generation of each slot, bumped when it is freed; nullptr without Handles
+    index_t cap; // slots allocated, sentinel included
+    index_t used; // slots handed out so far; links of slots >= used are uninitialised
+    index_t free_head; // first free slot, 0 if none
+    size_t sz;
+
+    bool live(index_t i) const { return i != 0 && i < used && prv[i] != nil; }
+
+    static void relocate(T *dst, T *src, std::true_type) { new (dst) T(static_cast<T &&>(*src)); }
+    static void relocate(T *dst, T *src, std::false_type) { new (dst) T(*src); }
+    /**
+     * move the slots into arrays of n slots; indices do not change
+     */
+    void grow(index_t n) {
+        T *v = static_cast<T *>(::operator new(sizeof(T) * n));
+        index_t *nx = nullptr, *pv = nullptr, *gn = nullptr;
+        index_t done = 0;
+        try {
+            nx = new index_t[n];
+            pv = new index_t[n];
+            if (Handles) gn = new index_t[n];
+            for (index_t i = nxt[0]; i != 0; i = nxt[i], ++done) {
+                relocate(v + i, vals + i, std::integral_constant<bool, std::is_nothrow_move_constructible<T>::value>());
+            }
+        } catch (...) {
+            for (index_t i = nxt[0]; done > 0; i = nxt[i], --done) v[i].~T();
+            delete [] gn;
+            delete [] pv;
+            delete [] nx;
+            ::operator delete(v);
+            throw;
+        }
+        std::memcpy(nx, nxt, sizeof(index_t) * used);
+        std::memcpy(pv, prv, sizeof(index_t) * used);
+        if (Handles) std::memcpy(gn, gen, sizeof(index_t) * used);
+        for (index_t i = nxt[0]; i != 0; i = nxt[i]) vals[i].~T();
+        free_arrays();
+        vals = v;
+        nxt = nx;
+        prv = pv;
+        gen = gn;
+        cap = n;
+    }
+    /**
+     * an unlinked slot, from the free list or the unused end of the arrays
+     */
+    index_t allocate() {
+        if (free_head) {
+            index_t i = free_head;
+            free_head = nxt[i];
+            return i;
+        }
+        if (used == cap) {
+            if (cap == nil) throw runtime_error();
+            grow(cap > nil / 2 ? nil : cap * 2);
+        }
+        if (Handles) gen[used] = 0;
+        return used++;
+    }
+    void release(index_t i) {
+        if (Handles) ++gen[i];
+        prv[i] = nil;
+        nxt[i] = free_head;
+        free_head = i;
+    }
+    void init(index_t n) {
+        vals = static_cast<T *>(::operator new(sizeof(T) * n));
+        nxt = new index_t[n];
+        prv = new index_t[n];
+        gen = nullptr;
+        if (Handles) gen = new index_t[n];
+        cap = n;
+        used = 1;
+        free_head = 0;
+        sz = 0;
+        nxt[0] = prv[0] = 0;
+    }
+    void free_arrays() {
+        ::operator delete(vals);
+        delete [] nxt;
+        delete [] prv;
+        delete [] gen;
+    }
+    /**
+     * link a new slot holding value before pos
+     */
+    index_t insert(index_t pos, const T &value) {
+        const T *src = &value;
+        index_t from = 0;
+        if (src > vals && src < vals + cap) from = static_cast<index_t>(src - vals); // an element of this list
+        index_t i = allocate();
+        if (from) src = vals + from;
+        try {
+            new (vals + i) T(*src);
+        } catch (...) {
+            release(i);
+            throw;
+        }
+        nxt[i] = pos;
+        prv[i] = prv[pos];
+        nxt[prv[pos]] = i;
+        prv[pos] = i;
+        ++sz;
+        return i;
+    }
+    void erase(index_t i) {
+        nxt[prv[i]] = nxt[i];
+        prv[nxt[i]] = prv[i];
+        vals[i].~T();
+        release(i);
+        --sz;
+    }
+
+public:
+    class const_iterator;
+    class iterator {
+    private:
+        index_t cur;
+        const index_list<T, Handles> *owner;
+    public:
+        iterator(): cur(0), owner(nullptr) {}
+        iterator(const index_list<T, Handles> *o, index_t c): cur(c), owner(o) {}
+        iterator operator++(int) {
+            iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+        iterator & operator++() {
+            if (owner == nullptr || !owner->live(cur)) throw invalid_iterator();
+            cur = owner->nxt[cur];
+            return *this;
+        }
+        iterator operator--(int) {
+            iterator tmp = *this;
+            --*this;
+            return tmp;
+        }
+        /**
+         * decrement from begin() is invalid; decrement from end() allowed only if list not empty
+         */
+        iterator & operator--() {
+            if (owner == nullptr) throw invalid_iterator();
+            if (cur == 0) {
+                if (owner->sz == 0) throw invalid_iterator();
+            } else if (!owner->live(cur) || owner->prv[cur] == 0) {
+                throw invalid_iterator();
+            }
+            cur = owner->prv[cur];
+            return *this;
+        }
+        T & operator *() const {
+            if (owner == nullptr || !owner->live(cur)) throw invalid_iterator();
+            return owner->vals[cur];
+        }
+        T * operator ->() const {
+            if (owner == nullptr || !owner->live(cur)) throw invalid_iterator();
+            return owner->vals + cur;
+        }
+        bool operator==(const iterator &rhs) const { return owner == rhs.owner && cur == rhs.cur; }
+        bool operator==(const const_iterator &rhs) const { return owner == rhs.owner && cur == rhs.cur; }
+        bool operator!=(const iterator &rhs) const { return !(*this == rhs); }
+        bool operator!=(const const_iterator &rhs) const { return !(*this == rhs); }
+
+        friend class index_list<T, Handles>;
+    };
+    class const_iterator {
+    private:
+        index_t cur;
+        const index_list<T, Handles> *owner;
+    public:
+        const_iterator(): cur(0), owner(nullptr) {}
+        const_iterator(const index_list<T, Handles> *o, index_t c): cur(c), owner(o) {}
+        const_iterator(const iterator &it): cur(it.cur), owner(it.owner) {}
+        const_iterator operator++(int) {
+            const_iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+        const_iterator & operator++() {
+            if (owner == nullptr || !owner->live(cur)) throw invalid_iterator();
+            cur = owner->nxt[cur];
+            return *this;
+        }
+        const_iterator operator--(int) {
+            const_iterator tmp = *this;
+            --*this;
+            return tmp;
+        }
+        const_iterator & operator--() {
+            if (owner == nullptr) throw invalid_iterator();
+            if (cur == 0) {
+                if (owner->sz == 0) throw invalid_iterator();
+            } else if (!owner->live(cur) || owner->prv[cur] == 0) {
+                throw invalid_iterator();
+            }
+            cur = owner->prv[cur];
+            return *this;
+        }
+        const T & operator *() const {
+            if (owner == nullptr || !owner->live(cur)) throw invalid_iterator();
+            return owner->vals[cur];
+        }
+        const T * operator ->() const {
+            if (owner == nullptr || !owner->live(cur)) throw invalid_iterator();
+            return owner->vals + cur;
+        }
+        bool operator==(const const_iterator &rhs) const { return owner == rhs.owner && cur == rhs.cur; }
+        bool operator==(const iterator &rhs) const { return owner == rhs.owner && cur == rhs.cur; }
+        bool operator!=(const const_iterator &rhs) const { return !(*this == rhs); }
+        bool operator!=(const iterator &rhs) const { return !(*this == rhs); }
+
+        friend class index_list<T, Handles>;
+    };
+
+    /**
+     * a stable reference to an element (index_list<T, true> only): 8 bytes, cheap to store in other data structures.
+     * it stays valid until the element is erased (or the list cleared or destroyed), across any growth;
+     * after that the list rejects it. a handle belongs to the list that issued it.
+     * a slot's generation wraps after 2^32 reuses, so a very old handle may in theory validate again
+     */
+    class handle {
+    private:
+        index_t slot;
+        index_t generation;
+    public:
+        handle(): slot(0), generation(0) {}
+        bool operator==(const handle &rhs) const { return slot == rhs.slot && generation == rhs.generation; }
+        bool operator!=(const handle &rhs) const { return !(*this == rhs); }
+
+        friend class index_list<T, Handles>;
+    };
+
+    index_list() { init(16); }
+    /**
+     * the copy is compact: its elements occupy slots 1..size() in order
+     */
+    index_list(const index_list &other) {
+        init(static_cast<index_t>(other.sz + 1));
+        try {
+            for (index_t i = other.nxt[0]; i != 0; i = other.nxt[i]) insert(0, other.vals[i]);
+        } catch (...) {
+            clear();
+            free_arrays();
+            throw;
+        }
+    }
+    ~index_list() {
+        clear();
+        free_arrays();
+    }
+    index_list &operator=(const index_list &other) {
+        if (this == &other) return *this;
+        clear();
+        reserve(other.sz);
+        for (index_t i = other.nxt[0]; i != 0; i = other.nxt[i]) insert(0, other.vals[i]);
+        return *this;
+    }
+
+    /**
+     * access the first / last element
+     * throw container_is_empty when the container is empty.
+     */
+    const T & front() const {
+        if (sz == 0) throw container_is_empty();
+        return vals[nxt[0]];
+    }
+    const T & back() const {
+        if (sz == 0) throw container_is_empty();
+        return vals[prv[0]];
+    }
+    iterator begin() { return iterator(this, nxt[0]); }
+    const_iterator cbegin() const { return const_iterator(this, nxt[0]); }
+    iterator end() { return iterator(this, 0); }
+    const_iterator cend() const { return const_iterator(this, 0); }
+    bool empty() const { return sz == 0; }
+    size_t size() const { return sz; }
+    /**
+     * number of elements the list can hold without growing its arrays
+     */
+    size_t capacity() const { return cap - 1; }
+    /**
+     * grow the arrays so that capacity() >= n
+     * throw runtime_error if n is beyond the 32-bit index range
+     */
+    void reserve(size_t n) {
+        if (n >= nil) throw runtime_error();
+        if (n + 1 > cap) grow(static_cast<index_t>(n + 1));
+    }
+
+    /**
+     * the handle of the element at pos
+     * throw if the iterator is invalid or end()
+     */
+    handle handle_of(const_iterator pos) const {
+        static_assert(Handles, "handles need index_list<T, true>");
+        if (pos.owner != this || !live(pos.cur)) throw invalid_iterator();
+        handle h;
+        h.slot = pos.cur;
+        h.generation = gen[pos.cur];
+        return h;
+    }
+    /**
+     * whether h still refers to an element of this list, in O(1)
+     */
+    bool valid(handle h) const {
+        static_assert(Handles, "handles need index_list<T, true>");
+        return live(h.slot) && gen[h.slot] == h.generation;
+    }
+    /**
+     * the iterator to the element of h, or end() if it was erased
+     */
+    iterator find(handle h) { return iterator(this, valid(h) ? h.slot : 0); }
+    const_iterator find(handle h) const { return const_iterator(this, valid(h) ? h.slot : 0); }
+    /**
+     * the element of h
+     * throw invalid_iterator if it was erased
+     */
+    T & at(handle h) {
+        if (!valid(h)) throw invalid_iterator();
+        return vals[h.slot];
+    }
+    const T & at(handle h) const {
+        if (!valid(h)) throw invalid_iterator();
+        return vals[h.slot];
+    }
+
+    /**
+     * erase every element; the arrays are kept and all handles become invalid
+     * (with Handles every slot is freed one by one, to bump its generation)
+     */
+    void clear() {
+        for (index_t i = nxt[0]; i != 0; ) {
+            index_t n = nxt[i];
+            vals[i].~T();
+            if (Handles) release(i);
+            i = n;
+        }
+        if (!Handles) {
+            used = 1;
+            free_head = 0;
+        }
+        nxt[0] = prv[0] = 0;
+        sz = 0;
+    }
+    /**
+     * insert value before pos (pos may be the end() iterator)
+     * return an iterator pointing to the inserted value
+     * throw if the iterator is invalid
+     */
+    iterator insert(iterator pos, const T &value) {
+        if (pos.owner != this || (pos.cur != 0 && !live(pos.cur))) throw invalid_iterator();
+        return iterator(this, insert(pos.cur, value));
+    }
+    /**
+     * remove the element at pos (the end() iterator is invalid)
+     * returns an iterator pointing to the following element
+     * throw if the container is empty, the iterator is invalid
+     */
+    iterator erase(iterator pos) {
+        if (pos.owner != this) throw invalid_iterator();
+        if (sz == 0) throw container_is_empty();
+        if (!live(pos.cur)) throw invalid_iterator();
+        index_t n = nxt[pos.cur];
+        erase(pos.cur);
+        return iterator(this, n);
+    }
+    void push_back(const T &value) { insert(0, value); }
+    void push_front(const T &value) { insert(nxt[0], value); }
+    /**
+     * throw when the container is empty.
+     */
+    void pop_back() {
+        if (sz == 0) throw container_is_empty();
+        erase(prv[0]);
+    }
+    void pop_front() {
+        if (sz == 0) throw container_is_empty();
+        erase(nxt[0]);
+    }
+    /**
+     * reverse the order of the elements by swapping the links, no elements are moved
+     */
+    void reverse() {
+        index_t i = 0;
+        do {
+            index_t n = nxt[i];
+            nxt[i] = prv[i];
+            prv[i] = n;
+            i = n;
+        } while (i != 0);
+    }
+};
+
+}
+
+#endif //SJTU_INDEX_LIST_HPP
@@ -6,8 +6,143 @@
 
 #include <climits>
 #include <cstddef>
+#include <cstring>
+#include <iostream>
+
+/**
+ * define SJTU_LIST_ENABLE_THREADS (and link with -pthread) for the multi-threaded operations of list;
+ * they are off by default since <thread> is not among the headers allowed on the OJ
+ */
+#ifdef SJTU_LIST_ENABLE_THREADS
+#include <exception>
+#include <thread>
+#endif
+
+/**
+ * define SJTU_LIST_ENABLE_INITIALIZER_LIST for construction and assign() from a braced list;
+ * off by default for the same reason, <initializer_list> is not allowed on the OJ
+ */
+#ifdef SJTU_LIST_ENABLE_INITIALIZER_LIST
+#include <initializer_list>
+#endif
+
+/**
+ * cache hint for pointer chasing; a no-op on compilers without the builtin
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define SJTU_LIST_PREFETCH(p) __builtin_prefetch(p)
+#else
+#define SJTU_LIST_PREFETCH(p) ((void)0)
+#endif
+
+namespace sjtu {
+/**
+ * the few type traits and the placement new that list needs,
+ * since neither <type_traits> nor <new> is among the headers allowed on the OJ
+ */
+namespace traits {
+template<bool B>
+struct bool_constant {
+    static const bool value = B;
+};
+typedef bool_constant<true> true_type;
+typedef bool_constant<false> false_type;
+
+template<bool B, typename U = void>
+struct enable_if {};
+template<typename U>
+struct enable_if<true, U> {
+    typedef U type;
+};
+
+template<typename U, typename V> struct is_same : false_type {};
+template<typename U> struct is_same<U, U> : true_type {};
+
+template<typename U> struct remove_cvref { typedef U type; };
+template<typename U> struct remove_cvref<U &> : remove_cvref<U> {};
+template<typename U> struct remove_cvref<U &&> : remove_cvref<U> {};
+template<typename U> struct remove_cvref<const U> : remove_cvref<U> {};
+template<typename U> struct remove_cvref<volatile U> : remove_cvref<U> {};
+template<typename U> struct remove_cvref<const volatile U> : remove_cvref<U> {};
+
+template<typename U> struct is_integral_base : false_type {};
+template<> struct is_integral_base<bool> : true_type {};
+template<> struct is_integral_base<char> : true_type {};
+template<> struct is_integral_base<signed char> : true_type {};
+template<> struct is_integral_base<unsigned char> : true_type {};
+template<> struct is_integral_base<wchar_t> : true_type {};
+template<> struct is_integral_base<char16_t> : true_type {};
+template<> struct is_integral_base<char32_t> : true_type {};
+#ifdef __cpp_char8_t
+template<> struct is_integral_base<char8_t> : true_type {};
+#endif
+template<> struct is_integral_base<short> : true_type {};
+template<> struct is_integral_base<unsigned short> : true_type {};
+template<> struct is_integral_base<int> : true_type {};
+template<> struct is_integral_base<unsigned int> : true_type {};
+template<> struct is_integral_base<long> : true_type {};
+template<> struct is_integral_base<unsigned long> : true_type {};
+template<> struct is_integral_base<long long> : true_type {};
+template<> struct is_integral_base<unsigned long long> : true_type {};
+template<typename U>
+struct is_integral : is_integral_base<typename remove_cvref<U>::type> {};
+
+/**
+ * for integral U only
+ */
+template<typename U>
+struct is_signed : bool_constant<(U(-1) < U(0))> {};
+
+/**
+ * compiler intrinsics where available; otherwise only integral types count, which merely disables fast paths
+ */
+#if defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER)
+template<typename U> struct is_trivial : bool_constant<__is_trivial(U)> {};
+template<typename U> struct is_trivially_copyable : bool_constant<__is_trivially_copyable(U)> {};
+#else
+template<typename U> struct is_trivial : is_integral<U> {};
+template<typename U> struct is_trivially_copyable : is_integral<U> {};
+#endif
+
+struct placement {};
+}
+}
+
+/**
+ * placement new selected by the sjtu::traits::placement tag, in place of the one declared in <new>
+ */
+inline void *operator new(std::size_t, sjtu::traits::placement, void *p) noexcept { return p; }
+inline void operator delete(void *, sjtu::traits::placement, void *) noexcept {}
 
 namespace sjtu {
+/**
+ * binary encoding of elements used by list::save / list::load.
+ * when raw is true the object representation is stored as is (native byte order), in large blocks;
+ * this is the default for trivially copyable T.
+ * other types must specialise this template with raw = false, e.g.
+ *   template<> struct element_codec<Util::Bint> {
+ *       static const bool raw = false;
+ *       static void encode(std::ostream &os, const Util::Bint &value);
+ *       static Util::Bint decode(std::istream &is); // throw on malformed input
+ *   };
+ */
+template<typename T>
+struct element_codec {
+    static const bool raw = traits::is_trivially_copyable<T>::value;
+    static void encode(std::ostream &os, const T &value) {
+        static_assert(raw, "specialise sjtu::element_codec to save this type");
+        os.write(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+    static T decode(std::istream &is) {
+        static_assert(raw, "specialise sjtu::element_codec to load this type");
+        char buf[sizeof(T)];
+        is.read(buf, sizeof(T));
+        T value;
+        std::memcpy(static_cast<void *>(&value), buf, sizeof(T));
+        return value;
+    }
+};
+
 /**
  * a data container like std::list
  * allocate random memory addresses for data and they are doubly-linked in a list.
@@ -15,6 +150,14 @@ namespace sjtu {
 template<typename T>
 class list {
 protected:
+    /**
+     * header of a chunk of nodes allocated at once
+     * the chunk is freed when the last of its nodes is destroyed, whichever list it belongs to by then
+     */
+    struct block {
+        size_t live; // nodes of this block not destroyed yet
+    };
+
     class node {
     public:
         /**
@@ -23,12 +166,506 @@ protected:
         node *prev;
         node *next;
         T *val; // nullptr for sentinel nodes
+        block *blk; // chunk holding this node and its value, nullptr if both were allocated alone
 
-        node(): prev(nullptr), next(nullptr), val(nullptr) {}
-        explicit node(const T &value): prev(nullptr), next(nullptr), val(new T(value)) {}
+        node(): prev(nullptr), next(nullptr), val(nullptr), blk(nullptr) {}
+        explicit node(const T &value): prev(nullptr), next(nullptr), val(new T(value)), blk(nullptr) {}
+        explicit node(T &&value): prev(nullptr), next(nullptr), val(new T(static_cast<T &&>(value))), blk(nullptr) {}
         ~node(){ if (val) { delete val; val = nullptr; } }
     };
 
+    /**
+     * a node next to the raw storage of its value
+     * shell must stay the first member: a node* is cast back to its slot
+     */
+    struct slot {
+        node shell;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+    static const size_t block_offset = (sizeof(block) + alignof(slot) - 1) / alignof(slot) * alignof(slot);
+
+    /**
+     * allocate a block of n slots; the nodes are default constructed and count as live,
+     * their values are left for the caller to construct (see construct_value)
+     * throw runtime_error if the size of the block does not fit in size_t
+     */
+    static block *allocate_block(size_t n) {
+        if (n > (static_cast<size_t>(-1) - block_offset) / sizeof(slot)) throw runtime_error();
+        char *raw = static_cast<char *>(::operator new(block_offset + n * sizeof(slot)));
+        block *b = ::new (traits::placement(), raw) block;
+        b->live = n;
+        slot *s = block_slots(b);
+        for (size_t i = 0; i < n; ++i) {
+            ::new (traits::placement(), &s[i].shell) node();
+            s[i].shell.blk = b;
+        }
+        return b;
+    }
+    /**
+     * elements per buffered write / read of save and load
+     */
+    static size_t io_chunk() { return sizeof(T) >= 65536 ? 1 : 65536 / sizeof(T); }
+    static slot *block_slots(block *b) {
+        return reinterpret_cast<slot *>(reinterpret_cast<char *>(b) + block_offset);
+    }
+    /**
+     * construct the value of a node living in a slot from arg (const T & or T &&)
+     */
+    template<typename V>
+    static void construct_value(node *cur, V &&arg) {
+        cur->val = ::new (traits::placement(), reinterpret_cast<slot *>(cur)->storage) T(static_cast<V &&>(arg));
+    }
+    /**
+     * destroy a node living in a block, freeing the block with its last node
+     */
+    static void destroy_block_node(node *cur) {
+        block *b = cur->blk;
+        if (cur->val) cur->val->~T();
+        cur->val = nullptr;
+        cur->~node();
+        if (--b->live == 0) ::operator delete(b);
+    }
+    /**
+     * build n nodes in a single block with values copied from *first, *++first, ...
+     * the nodes are chained by prev / next (not linked into any list); returns the first, sets last.
+     * if a copy throws, everything built so far is released.
+     */
+    template<typename InputIt>
+    static node *build_block(InputIt first, size_t n, node *&last) {
+        block *b = allocate_block(n);
+        slot *s = block_slots(b);
+        try {
+            for (size_t i = 0; i < n; ++i, ++first) construct_value(&s[i].shell, *first);
+        } catch (...) {
+            for (size_t k = 0; k < n; ++k) destroy_block_node(&s[k].shell);
+            throw;
+        }
+        for (size_t k = 1; k < n; ++k) {
+            s[k - 1].shell.next = &s[k].shell;
+            s[k].shell.prev = &s[k - 1].shell;
+        }
+        last = &s[n - 1].shell;
+        return &s[0].shell;
+    }
+    template<typename InputIt>
+    static size_t count_range(InputIt first, InputIt last) {
+        size_t n = 0;
+        for (; first != last; ++first) ++n;
+        return n;
+    }
+    /**
+     * an endless range repeating one value, to build n copies with build_block
+     */
+    struct fill_iterator {
+        const T *v;
+        const T & operator *() const { return *v; }
+        fill_iterator & operator++() { return *this; }
+    };
+    /**
+     * link the n nodes of arr, in order, between the sentinels first and last
+     */
+    static void relink_array(node *first, node *last, node **arr, size_t n) {
+        node *prev = first;
+        for (size_t k = 0; k < n; ++k) {
+            prev->next = arr[k];
+            arr[k]->prev = prev;
+            prev = arr[k];
+        }
+        prev->next = last;
+        last->prev = prev;
+    }
+    /**
+     * a node with its radix key, see radix_relink
+     */
+    struct radix_item {
+        unsigned long long key;
+        node *p;
+    };
+    /**
+     * an integral key mapped to an unsigned one of the same order
+     */
+    template<typename K>
+    static unsigned long long radix_key(K k) {
+        static_assert(traits::is_integral<K>::value, "radix keys must be integral");
+        if (traits::is_signed<K>::value) return static_cast<unsigned long long>(static_cast<long long>(k)) ^ (1ULL << 63);
+        return static_cast<unsigned long long>(k);
+    }
+    /**
+     * stable LSD radix sort of the sz items by key, one byte per pass, then link the nodes in that order.
+     * bytes that are equal in every key are skipped, so narrow or small keys cost few passes
+     * takes ownership of items
+     */
+    void radix_relink(radix_item *items) {
+        unsigned long long diff = 0;
+        for (size_t i = 1; i < sz; ++i) diff |= items[i].key ^ items[0].key;
+        radix_item *src = items, *dst = new radix_item[sz];
+        size_t count[256];
+        for (int shift = 0; shift < 64; shift += 8) {
+            if (((diff >> shift) & 0xff) == 0) continue;
+            std::memset(count, 0, sizeof(count));
+            for (size_t i = 0; i < sz; ++i) ++count[(src[i].key >> shift) & 0xff];
+            size_t sum = 0;
+            for (int d = 0; d < 256; ++d) {
+                size_t c = count[d];
+                count[d] = sum;
+                sum += c;
+            }
+            for (size_t i = 0; i < sz; ++i) dst[count[(src[i].key >> shift) & 0xff]++] = src[i];
+            radix_item *t = src;
+            src = dst;
+            dst = t;
+        }
+        node *prev = head;
+        for (size_t i = 0; i < sz; ++i) {
+            prev->next = src[i].p;
+            src[i].p->prev = prev;
+            prev = src[i].p;
+        }
+        prev->next = tail;
+        tail->prev = prev;
+        delete [] src;
+        delete [] dst;
+    }
+    /**
+     * sort() for integral T: radix sort on the values once the list is long enough to amortise the passes.
+     * both versions are templates on U == T, so an explicit instantiation of list<T> only compiles the one used
+     */
+    template<typename U = T>
+    typename traits::enable_if<traits::is_integral<U>::value>::type sort_values() {
+        if (sz < 256) {
+            comparison_sort(traits::true_type());
+            return;
+        }
+        radix_sort([](const T &value) { return value; });
+    }
+    /**
+     * sort() for other T: comparison sort, on a copy of the values when T is small and trivial
+     */
+    template<typename U = T>
+    typename traits::enable_if<!traits::is_integral<U>::value>::type sort_values() {
+        comparison_sort(traits::bool_constant<traits::is_trivial<T>::value && sizeof(T) <= 2 * sizeof(void *)>());
+    }
+    /**
+     * sort copies of the values in a contiguous buffer and write them back in order.
+     * comparisons then read adjacent memory instead of chasing node->val;
+     * the nodes keep their places, only the values they hold change
+     */
+    void comparison_sort(traits::true_type) {
+        T *vals = new T[sz];
+        size_t i = 0;
+        for (node *p = head->next; p != tail; p = p->next) {
+            prefetch_next(p);
+            vals[i++] = *(p->val);
+        }
+        try {
+            natural_sort(vals, sz, [](const T &a, const T &b) { return a < b; });
+        } catch (...) {
+            delete [] vals;
+            throw;
+        }
+        i = 0;
+        for (node *p = head->next; p != tail; p = p->next) {
+            prefetch_next(p);
+            *(p->val) = vals[i++];
+        }
+        delete [] vals;
+    }
+    /**
+     * sort the node pointers and relink, no element is copied
+     */
+    void comparison_sort(traits::false_type) {
+        node **arr = new node*[sz];
+        size_t i = 0;
+        for (node *p = head->next; p != tail; p = p->next) {
+            prefetch_next(p);
+            arr[i++] = p;
+        }
+        try {
+            natural_sort(arr, sz, [](node *a, node *b) { return *(a->val) < *(b->val); });
+        } catch (...) {
+            delete [] arr;
+            throw;
+        }
+        relink_array(head, tail, arr, sz);
+        delete [] arr;
+    }
+    /**
+     * read cnt elements written by save into one new block and append it (buf holds io_chunk() raw elements)
+     * if reading fails, the block is released and runtime_error thrown
+     * (a template on U == T, like save and load, so that element_codec<T> is only used when they are)
+     */
+    template<typename U>
+    void load_block(std::istream &is, size_t cnt, char *buf) {
+        block *b = allocate_block(cnt);
+        slot *s = block_slots(b);
+        try {
+            if (element_codec<U>::raw) {
+                if (!is.read(buf, cnt * sizeof(T))) throw runtime_error();
+                for (size_t k = 0; k < cnt; ++k) {
+                    std::memcpy(static_cast<void *>(s[k].storage), buf + k * sizeof(T), sizeof(T));
+                    s[k].shell.val = reinterpret_cast<T *>(s[k].storage);
+                }
+            } else {
+                for (size_t k = 0; k < cnt; ++k) {
+                    construct_value(&s[k].shell, element_codec<U>::decode(is));
+                    if (!is) throw runtime_error();
+                }
+            }
+        } catch (...) {
+            // slots that hold values are released together with the rest of the block
+            for (size_t k = 0; k < cnt; ++k) destroy_block_node(&s[k].shell);
+            throw;
+        }
+        for (size_t k = 1; k < cnt; ++k) {
+            s[k - 1].shell.next = &s[k].shell;
+            s[k].shell.prev = &s[k - 1].shell;
+        }
+        link_chain(tail, &s[0].shell, &s[cnt - 1].shell, cnt);
+    }
+    /**
+     * construct the value of dst from *src, moving only when that cannot throw (see compact)
+     */
+    static void relocate_value(node *dst, T *src, traits::true_type) { construct_value(dst, static_cast<T &&>(*src)); }
+    static void relocate_value(node *dst, T *src, traits::false_type) { construct_value(dst, static_cast<const T &>(*src)); }
+    static list &as_list(list &l) { return l; }
+    static list &as_list(list *l) { return *l; }
+    /**
+     * move the nodes of other from its first one up to (excluding) stop before pos, with one relink
+     * sizes are left to the caller
+     */
+    static void splice_front(list &other, node *stop, node *pos) {
+        node *first = other.head->next;
+        node *last = stop->prev;
+        other.head->next = stop;
+        stop->prev = other.head;
+        first->prev = pos->prev;
+        pos->prev->next = first;
+        last->next = pos;
+        pos->prev = last;
+    }
+    /**
+     * the first node from `from` (up to stop) for which pred is false, given that pred holds on a prefix of the chain.
+     * probes nodes at distances 1, 3, 7, 15 ... and then bisects the last gap, so skipping k nodes takes
+     * O(log k) calls of pred (and O(k) pointer steps, which a linked list cannot avoid)
+     */
+    template<typename Pred>
+    static node *gallop(node *from, node *stop, Pred pred) {
+        if (from == stop || !pred(from)) return from;
+        node *lo = from; // pred(lo) holds
+        node *hi = stop; // pred(hi) fails, or hi is stop
+        size_t gap = 0; // distance from lo to hi, known once hi is found
+        for (size_t step = 1; ; step *= 2) {
+            node *q = lo;
+            size_t k = 0;
+            while (k < step && q != stop) {
+                q = q->next;
+                ++k;
+            }
+            if (q != stop && pred(q)) {
+                lo = q;
+                continue;
+            }
+            hi = q;
+            gap = k;
+            break;
+        }
+        while (gap > 1) {
+            size_t half = gap / 2;
+            node *mid = lo;
+            for (size_t k = 0; k < half; ++k) mid = mid->next;
+            if (pred(mid)) {
+                lo = mid;
+                gap -= half;
+            } else {
+                hi = mid;
+                gap = half;
+            }
+        }
+        return hi;
+    }
+    /**
+     * stable adaptive merge sort of a[0, n) (natural runs, galloping merges, after TimSort).
+     * ascending and strictly descending runs already present are detected and kept,
+     * so sorted, reversed or few-run input costs close to O(n) comparisons; the worst case is O(n log n).
+     * E must be cheap to copy (node pointers, small keys); uses n extra elements of memory.
+     */
+    template<typename E, typename Less>
+    static void natural_sort(E *a, size_t n, Less less) {
+        if (n <= 1) return;
+        E *tmp = new E[n];
+        size_t min_run = n;
+        size_t r = 0;
+        while (min_run >= 64) {
+            r |= min_run & 1;
+            min_run >>= 1;
+        }
+        min_run += r;
+        size_t run_base[90], run_len[90]; // run lengths grow at least like fibonacci numbers
+        int runs = 0;
+        size_t min_gallop = 7;
+        try {
+            for (size_t lo = 0; lo < n; ) {
+                size_t len = count_run(a + lo, n - lo, less);
+                if (len < min_run) {
+                    size_t forced = n - lo < min_run ? n - lo : min_run;
+                    insertion_sort(a + lo, forced, len, less);
+                    len = forced;
+                }
+                run_base[runs] = lo;
+                run_len[runs] = len;
+                ++runs;
+                lo += len;
+                // keep run lengths decreasing fast enough that merges stay balanced
+                while (runs > 1) {
+                    int k = runs - 2;
+                    if ((k > 0 && run_len[k - 1] <= run_len[k] + run_len[k + 1]) ||
+                        (k > 1 && run_len[k - 2] <= run_len[k - 1] + run_len[k])) {
+                        if (run_len[k - 1] < run_len[k + 1]) --k;
+                    } else if (run_len[k] > run_len[k + 1]) {
+                        break;
+                    }
+                    merge_runs(a, tmp, run_base[k], run_len[k], run_len[k + 1], min_gallop, less);
+                    run_len[k] += run_len[k + 1];
+                    for (int t = k + 1; t + 1 < runs; ++t) {
+                        run_base[t] = run_base[t + 1];
+                        run_len[t] = run_len[t + 1];
+                    }
+                    --runs;
+                }
+            }
+            while (runs > 1) {
+                int k = runs - 2;
+                if (k > 0 && run_len[k - 1] < run_len[k + 1]) --k;
+                merge_runs(a, tmp, run_base[k], run_len[k], run_len[k + 1], min_gallop, less);
+                run_len[k] += run_len[k + 1];
+                for (int t = k + 1; t + 1 < runs; ++t) {
+                    run_base[t] = run_base[t + 1];
+                    run_len[t] = run_len[t + 1];
+                }
+                --runs;
+            }
+        } catch (...) {
+            delete [] tmp;
+            throw;
+        }
+        delete [] tmp;
+    }
+    /**
+     * length of the run starting at a[0]; a strictly descending run is reversed in place
+     */
+    template<typename E, typename Less>
+    static size_t count_run(E *a, size_t n, Less &less) {
+        if (n == 1) return 1;
+        size_t k = 2;
+        if (less(a[1], a[0])) {
+            while (k < n && less(a[k], a[k - 1])) ++k;
+            for (size_t i = 0, j = k - 1; i < j; ++i, --j) {
+                E t = a[i];
+                a[i] = a[j];
+                a[j] = t;
+            }
+        } else {
+            while (k < n && !less(a[k], a[k - 1])) ++k;
+        }
+        return k;
+    }
+    /**
+     * binary insertion sort of a[0, n) whose prefix a[0, sorted) is already sorted
+     */
+    template<typename E, typename Less>
+    static void insertion_sort(E *a, size_t n, size_t sorted, Less &less) {
+        for (size_t i = sorted; i < n; ++i) {
+            E x = a[i];
+            size_t pos = gallop_right(x, a, i, less);
+            for (size_t j = i; j > pos; --j) a[j] = a[j - 1];
+            a[pos] = x;
+        }
+    }
+    /**
+     * number of leading elements of sorted a[0, n) that are <= key (so key goes after equal ones)
+     * exponential search from the front, then binary search: O(log k) for an answer k
+     */
+    template<typename E, typename Less>
+    static size_t gallop_right(const E &key, const E *a, size_t n, Less &less) {
+        size_t lo = 0, hi = 1;
+        while (hi < n && !less(key, a[hi - 1])) {
+            lo = hi;
+            hi = hi * 2 + 1;
+        }
+        if (hi > n) hi = n;
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (less(key, a[mid])) hi = mid; else lo = mid + 1;
+        }
+        return lo;
+    }
+    /**
+     * number of leading elements of sorted a[0, n) that are < key
+     */
+    template<typename E, typename Less>
+    static size_t gallop_left(const E &key, const E *a, size_t n, Less &less) {
+        size_t lo = 0, hi = 1;
+        while (hi < n && less(a[hi - 1], key)) {
+            lo = hi;
+            hi = hi * 2 + 1;
+        }
+        if (hi > n) hi = n;
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (less(a[mid], key)) lo = mid + 1; else hi = mid;
+        }
+        return lo;
+    }
+    /**
+     * stably merge the adjacent sorted runs a[base, base + na) and a[base + na, base + na + nb)
+     * elements of the first run already in place and of the second run beyond the first run's maximum are skipped;
+     * then the merge switches to galloping while one side keeps winning (min_gallop adapts across merges)
+     */
+    template<typename E, typename Less>
+    static void merge_runs(E *a, E *tmp, size_t base, size_t na, size_t nb, size_t &min_gallop, Less &less) {
+        E *pa = a + base;
+        E *pb = pa + na;
+        size_t skip = gallop_right(pb[0], pa, na, less);
+        pa += skip;
+        na -= skip;
+        if (na == 0) return;
+        nb = gallop_left(pa[na - 1], pb, nb, less);
+        if (nb == 0) return;
+        for (size_t i = 0; i < na; ++i) tmp[i] = pa[i];
+        size_t i = 0, j = 0, k = 0; // into tmp (first run), pb (second run), pa (output)
+        while (i < na && j < nb) {
+            size_t win_a = 0, win_b = 0;
+            while (i < na && j < nb && (win_a | win_b) < min_gallop) {
+                if (less(pb[j], tmp[i])) {
+                    pa[k++] = pb[j++];
+                    ++win_b;
+                    win_a = 0;
+                } else {
+                    pa[k++] = tmp[i++];
+                    ++win_a;
+                    win_b = 0;
+                }
+            }
+            while (i < na && j < nb) {
+                size_t ca = gallop_right(pb[j], tmp + i, na - i, less);
+                for (size_t t = 0; t < ca; ++t) pa[k++] = tmp[i++];
+                if (i == na) break;
+                pa[k++] = pb[j++];
+                if (j == nb) break;
+                size_t cb = gallop_left(tmp[i], pb + j, nb - j, less);
+                for (size_t t = 0; t < cb; ++t) pa[k++] = pb[j++]; // k < position of pb[j], safe in place
+                if (j == nb) break;
+                pa[k++] = tmp[i++];
+                if (min_gallop > 1) --min_gallop;
+                if (ca < 7 && cb < 7) {
+                    min_gallop += 2;
+                    break;
+                }
+            }
+        }
+        while (i < na) pa[k++] = tmp[i++]; // what remains of the second run is already in place
+    }
+
 protected:
     /**
      * add data members for linked list as protected members
@@ -36,6 +673,138 @@ protected:
     node *head; // sentinel head (no value)
     node *tail; // sentinel tail (no value)
     size_t sz;
+    node sentinel[2]; // storage of head and tail, so an empty list allocates nothing
+    node *spare; // block nodes without a value, reused by create_node; chained by next
+    size_t spare_cnt;
+    bool retain; // whether destroy_node keeps block nodes on the spare chain
+
+    /**
+     * link head and tail of an empty list
+     */
+    void init() {
+        head = &sentinel[0];
+        tail = &sentinel[1];
+        head->next = tail; head->prev = nullptr;
+        tail->prev = head; tail->next = nullptr;
+        sz = 0;
+        spare = nullptr;
+        spare_cnt = 0;
+        retain = false;
+    }
+    /**
+     * allocate an unlinked node holding a copy of value
+     * derived containers override this (with destroy_node) to use their own storage
+     */
+    virtual node *create_node(const T &value) {
+        if (spare) {
+            node *cur = spare;
+            construct_value(cur, value);
+            spare = cur->next;
+            --spare_cnt;
+            cur->next = nullptr;
+            return cur;
+        }
+        if (!retain) return new node(value);
+        // a node of its own block, so that it can be retained later
+        node *cur = &block_slots(allocate_block(1))->shell;
+        try {
+            construct_value(cur, value);
+        } catch (...) {
+            destroy_block_node(cur);
+            throw;
+        }
+        return cur;
+    }
+    /**
+     * destroy the value of an unlinked node and release its memory (or keep the node, see retain_nodes)
+     */
+    virtual void destroy_node(node *cur) {
+        if (retain && cur->blk) {
+            cur->val->~T();
+            cur->val = nullptr;
+            cur->prev = nullptr;
+            cur->next = spare;
+            spare = cur;
+            ++spare_cnt;
+        } else {
+            dispose(cur);
+        }
+    }
+    /**
+     * destroy an unlinked node that was allocated by list itself (alone or in a block)
+     */
+    static void dispose(node *cur) {
+        if (cur->blk) destroy_block_node(cur);
+        else delete cur;
+    }
+    /**
+     * free every spare node
+     */
+    void release_spare() {
+        while (spare) {
+            node *n = spare->next;
+            destroy_block_node(spare);
+            spare = n;
+        }
+        spare_cnt = 0;
+    }
+    /**
+     * called on a list before its nodes are relinked into another list (e.g. merge)
+     * afterwards every node must be releasable by destroy_node of any list
+     */
+    virtual void spill() {}
+    /**
+     * called on a node just unlinked from this list that is about to leave it (extract)
+     * returns the node to hand out, which must be releasable by dispose
+     */
+    virtual node *detach_node(node *cur) { return cur; }
+    /**
+     * link the chain first ... last of n nodes before pos
+     */
+    void link_chain(node *pos, node *first, node *last, size_t n) {
+        node *before = pos->prev;
+        before->next = first;
+        first->prev = before;
+        last->next = pos;
+        pos->prev = last;
+        sz += n;
+    }
+    /**
+     * replace the contents with n values read from first, allocated as one block
+     * the old contents are kept if a copy throws
+     */
+    template<typename InputIt>
+    void assign_block(InputIt first, size_t n) {
+        if (n == 0) {
+            clear();
+            return;
+        }
+        node *last;
+        node *chain = build_block(first, n, last);
+        clear();
+        link_chain(tail, chain, last, n);
+    }
+    /**
+     * hint the cache about the node after the successor of cur and the value of that successor
+     * call while working on cur, so the chain is fetched ahead of the traversal
+     */
+    static void prefetch_next(const node *cur) {
+        const node *n = cur->next;
+        SJTU_LIST_PREFETCH(n->next);
+        SJTU_LIST_PREFETCH(n->val);
+    }
+    /**
+     * destroy n nodes chained by next starting at first, already unlinked from the list
+     * (the last of them may still point into the list, or be null terminated)
+     */
+    void destroy_run(node *first, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            node *nxt = first->next;
+            if (nxt) prefetch_next(first);
+            destroy_node(first);
+            first = nxt;
+        }
+    }
 
     /**
      * insert node cur before node pos
@@ -68,7 +837,7 @@ protected:
 public:
     class const_iterator;
     class iterator {
-    private:
+    protected:
         /**
          * TODO add data members
          *   just add whatever you want.
@@ -223,25 +992,100 @@ public:
 
         friend class list<T>;
     };
-    
+    /**
+     * an iterator that prefetches the node after its successor, and the successor's value, on every ++,
+     * so the pointer chase overlaps with the work done on the current element.
+     * opt-in for long forward loops over lists much larger than the cache;
+     * converts to / compares with iterator, and is invalidated exactly like iterator:
+     * only nodes reached through the current one are touched, so erasing other elements is safe.
+     */
+    class prefetch_iterator : public iterator {
+    private:
+        void prefetch() {
+            if (this->cur != nullptr && this->cur->next != nullptr) prefetch_next(this->cur);
+        }
+    public:
+        prefetch_iterator(): iterator() {}
+        prefetch_iterator(const iterator &it): iterator(it) { prefetch(); }
+        prefetch_iterator & operator++() {
+            iterator::operator++();
+            prefetch();
+            return *this;
+        }
+        prefetch_iterator operator++(int) {
+            prefetch_iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+    };
+    /**
+     * owns an element removed from a list by extract(), together with its node.
+     * it can be inserted into any list<T> (or list derived from it) without copying or allocating;
+     * otherwise the element is destroyed with the handle. movable, not copyable.
+     */
+    class node_handle {
+    private:
+        node *nd;
+        explicit node_handle(node *n): nd(n) {}
+    public:
+        node_handle(): nd(nullptr) {}
+        node_handle(node_handle &&other): nd(other.nd) { other.nd = nullptr; }
+        node_handle(const node_handle &) = delete;
+        node_handle &operator=(node_handle &&other) {
+            if (this != &other) {
+                if (nd) dispose(nd);
+                nd = other.nd;
+                other.nd = nullptr;
+            }
+            return *this;
+        }
+        node_handle &operator=(const node_handle &) = delete;
+        ~node_handle() { if (nd) dispose(nd); }
+        bool empty() const { return nd == nullptr; }
+        explicit operator bool() const { return nd != nullptr; }
+        /**
+         * throw container_is_empty if the handle is empty
+         */
+        T & value() const {
+            if (nd == nullptr) throw container_is_empty();
+            return *(nd->val);
+        }
+
+        friend class list<T>;
+    };
+
     /**
      * TODO Constructs
      * Atleast two: default constructor, copy constructor
      */
-    list() {
-        head = new node();
-        tail = new node();
-        head->next = tail; head->prev = nullptr;
-        tail->prev = head; tail->next = nullptr;
-        sz = 0;
+    list() { init(); }
+    /**
+     * construct from a range, n copies of value, or an initializer list;
+     * all nodes are allocated as one block and linked in a single pass.
+     * a range is traversed twice (to count it first), so it must be a forward range.
+     * the block is freed only when the last of its nodes is destroyed: a single element moved on to another
+     * list (merge, merge_all, extract) keeps the whole block allocated. its node count is not atomic, so two
+     * lists that exchanged nodes this way must not be modified on different threads at the same time.
+     */
+    template<typename InputIt, typename = typename traits::enable_if<!traits::is_integral<InputIt>::value>::type>
+    list(InputIt first, InputIt last) {
+        init();
+        assign_block(first, count_range(first, last));
+    }
+    list(size_t n, const T &value) {
+        init();
+        assign_block(fill_iterator{&value}, n);
     }
+#ifdef SJTU_LIST_ENABLE_INITIALIZER_LIST
+    list(std::initializer_list<T> il) {
+        init();
+        assign_block(il.begin(), il.size());
+    }
+#endif
     list(const list &other) {
-        head = new node();
-        tail = new node();
-        head->next = tail; head->prev = nullptr;
-        tail->prev = head; tail->next = nullptr;
-        sz = 0;
+        init();
         for (node *p = other.head->next; p != other.tail; p = p->next) {
+            prefetch_next(p);
             push_back(*(p->val));
         }
     }
@@ -250,8 +1094,7 @@ public:
      */
     virtual ~list() {
         clear();
-        delete head; head = nullptr;
-        delete tail; tail = nullptr;
+        release_spare();
     }
     /**
      * TODO Assignment operator
@@ -260,10 +1103,83 @@ public:
         if (this == &other) return *this;
         clear();
         for (node *p = other.head->next; p != other.tail; p = p->next) {
+            prefetch_next(p);
             push_back(*(p->val));
         }
         return *this;
     }
+#ifdef SJTU_LIST_ENABLE_THREADS
+    /**
+     * replace the contents with a copy of other, copy-constructing the elements on several threads:
+     * the nodes are first allocated as one block, then each thread constructs a contiguous share of the values.
+     * worth it when copying an element is expensive (matrices, big integers); T's copy constructor must be
+     * safe to run concurrently on distinct elements.
+     * threads == 0 uses std::thread::hardware_concurrency(). the old contents are kept if a copy throws.
+     */
+    void assign_parallel(const list &other, unsigned threads = 0) {
+        if (this == &other) return;
+        size_t n = other.sz;
+        if (n == 0) {
+            clear();
+            return;
+        }
+        if (threads == 0) threads = std::thread::hardware_concurrency();
+        if (threads == 0) threads = 1;
+        if (threads > n) threads = n;
+        const node **src = new const node *[n];
+        size_t i = 0;
+        for (const node *p = other.head->next; p != other.tail; p = p->next) {
+            prefetch_next(p);
+            src[i++] = p;
+        }
+        block *b = allocate_block(n);
+        slot *s = block_slots(b);
+        std::exception_ptr *errors = new std::exception_ptr[threads];
+        auto work = [&](unsigned t) {
+            size_t lo = n / threads * t + (t < n % threads ? t : n % threads);
+            size_t hi = lo + n / threads + (t < n % threads ? 1 : 0);
+            try {
+                for (size_t k = lo; k < hi; ++k) construct_value(&s[k].shell, *(src[k]->val));
+            } catch (...) {
+                errors[t] = std::current_exception();
+            }
+        };
+        std::thread *workers = new std::thread[threads - 1];
+        unsigned started = 0;
+        try {
+            for (; started + 1 < threads; ++started) workers[started] = std::thread(work, started);
+        } catch (...) {
+            errors[threads - 1] = std::current_exception(); // could not start a thread, no copy is attempted below
+        }
+        if (!errors[threads - 1]) work(threads - 1);
+        for (unsigned t = 0; t < started; ++t) workers[t].join();
+        delete [] workers;
+        delete [] src;
+        std::exception_ptr failure;
+        for (unsigned t = 0; t < threads && !failure; ++t) failure = errors[t];
+        delete [] errors;
+        if (failure) {
+            for (size_t k = 0; k < n; ++k) destroy_block_node(&s[k].shell);
+            std::rethrow_exception(failure);
+        }
+        for (size_t k = 1; k < n; ++k) {
+            s[k - 1].shell.next = &s[k].shell;
+            s[k].shell.prev = &s[k - 1].shell;
+        }
+        clear();
+        link_chain(tail, &s[0].shell, &s[n - 1].shell, n);
+    }
+#endif
+    /**
+     * replace the contents, as the constructors above (one shared block, with the same caveats);
+     * the old contents are kept if a copy throws
+     */
+    template<typename InputIt, typename = typename traits::enable_if<!traits::is_integral<InputIt>::value>::type>
+    void assign(InputIt first, InputIt last) { assign_block(first, count_range(first, last)); }
+    void assign(size_t n, const T &value) { assign_block(fill_iterator{&value}, n); }
+#ifdef SJTU_LIST_ENABLE_INITIALIZER_LIST
+    void assign(std::initializer_list<T> il) { assign_block(il.begin(), il.size()); }
+#endif
     /**
      * access the first / last element
      * throw container_is_empty when the container is empty.
@@ -280,6 +1196,7 @@ public:
      * returns an iterator to the beginning.
      */
     iterator begin() { return iterator(this, sz ? head->next : tail); }
+    prefetch_iterator prefetch_begin() { return prefetch_iterator(begin()); }
     const_iterator cbegin() const { return const_iterator(this, sz ? head->next : tail); }
     /**
      * returns an iterator to the end.
@@ -295,6 +1212,34 @@ public:
      */
     virtual size_t size() const { return sz; }
 
+    /**
+     * number of elements the list can hold without allocating
+     */
+    size_t capacity() const { return sz + spare_cnt; }
+    /**
+     * preallocate spare nodes, as one block, so that capacity() >= n.
+     * nodes taken from it share that block as described at the range constructor
+     */
+    void reserve(size_t n) {
+        if (n <= sz + spare_cnt) return;
+        size_t cnt = n - sz - spare_cnt;
+        slot *s = block_slots(allocate_block(cnt));
+        for (size_t i = cnt; i-- > 0; ) {
+            s[i].shell.next = spare;
+            spare = &s[i].shell;
+        }
+        spare_cnt += cnt;
+    }
+    /**
+     * when on, nodes removed by clear / erase / pop / unique stay on a spare chain of this list
+     * and are reused by later insertions, so a fill-clear-refill cycle allocates nothing once warm.
+     * nodes created while on are allocated so that they can be retained.
+     */
+    void retain_nodes(bool on = true) { retain = on; }
+    /**
+     * free all spare nodes
+     */
+    void shrink_to_fit() { release_spare(); }
     /**
      * clears the contents
      */
@@ -302,7 +1247,8 @@ public:
         node *p = head->next;
         while (p != tail) {
             node *n = p->next;
-            delete p;
+            prefetch_next(p);
+            destroy_node(p);
             p = n;
         }
         head->next = tail;
@@ -317,7 +1263,7 @@ public:
     virtual iterator insert(iterator pos, const T &value) {
         if (pos.owner != this || pos.cur == nullptr) throw invalid_iterator();
         node *p = pos.cur;
-        node *nd = new node(value);
+        node *nd = create_node(value);
         // insert before p
         nd->prev = p->prev;
         nd->next = p;
@@ -339,7 +1285,7 @@ public:
         node *nxt = p->next;
         p->prev->next = p->next;
         p->next->prev = p->prev;
-        delete p;
+        destroy_node(p);
         --sz;
         return iterator(this, nxt);
     }
@@ -369,24 +1315,259 @@ public:
         iterator it(this, head->next);
         erase(it);
     }
+    /**
+     * unlink the element at pos and hand it over in a node handle, without copying it
+     * invalidates only iterators to pos
+     * throw if the container is empty, the iterator is invalid
+     */
+    node_handle extract(iterator pos) {
+        if (pos.owner != this || pos.cur == nullptr) throw invalid_iterator();
+        if (sz == 0) throw container_is_empty();
+        node *p = pos.cur;
+        if (p == tail || p->val == nullptr) throw invalid_iterator();
+        p->prev->next = p->next;
+        p->next->prev = p->prev;
+        p->prev = p->next = nullptr;
+        --sz;
+        return node_handle(detach_node(p));
+    }
+    /**
+     * link the node owned by nh before pos; nh becomes empty
+     * returns an iterator to the inserted element, or end() if nh was empty
+     * throw if the iterator is invalid
+     */
+    iterator insert(iterator pos, node_handle &&nh) {
+        if (pos.owner != this || pos.cur == nullptr || pos.cur == head) throw invalid_iterator();
+        if (nh.nd == nullptr) return end();
+        node *p = pos.cur;
+        node *nd = nh.nd;
+        nh.nd = nullptr;
+        nd->prev = p->prev;
+        nd->next = p;
+        p->prev->next = nd;
+        p->prev = nd;
+        ++sz;
+        return iterator(this, nd);
+    }
+    /**
+     * remove every element e with pred(e) / e == value in one pass
+     * matching nodes are unlinked onto a private chain and freed together afterwards,
+     * so value may refer to an element of this list.
+     * returns the number of elements removed; if pred throws, the elements matched so far stay removed
+     */
+    template<typename Pred>
+    size_t remove_if(Pred pred) {
+        node *dead = nullptr;
+        size_t n = 0;
+        try {
+            for (node *p = head->next; p != tail; ) {
+                node *nxt = p->next;
+                prefetch_next(p);
+                if (pred(*(p->val))) {
+                    p->prev->next = nxt;
+                    nxt->prev = p->prev;
+                    p->next = dead;
+                    dead = p;
+                    ++n;
+                }
+                p = nxt;
+            }
+        } catch (...) {
+            sz -= n;
+            destroy_run(dead, n);
+            throw;
+        }
+        sz -= n;
+        destroy_run(dead, n);
+        return n;
+    }
+    size_t remove(const T &value) {
+        return remove_if([&value](const T &e) { return e == value; });
+    }
+    /**
+     * remove every element equal (operator==) to an earlier one, keeping first occurrences in order;
+     * unlike unique() the duplicates need not be adjacent.
+     * hash(const T &) must return equal values (convertible to size_t) for equal elements.
+     * one pass with an internal open-addressing table: O(n) expected, O(n) extra memory.
+     * returns the number of elements removed; if hash or operator== throws, the duplicates found so far stay removed
+     */
+    template<typename Hash>
+    size_t dedupe(Hash hash) {
+        if (sz <= 1) return 0;
+        struct entry {
+            size_t h;
+            node *first; // nullptr for an empty entry
+        };
+        int bits = 1;
+        while ((size_t(1) << bits) < sz * 2) ++bits;
+        const size_t mask = (size_t(1) << bits) - 1;
+        entry *table = new entry[mask + 1];
+        for (size_t i = 0; i <= mask; ++i) table[i].first = nullptr;
+        node *dead = nullptr;
+        size_t n = 0;
+        try {
+            for (node *p = head->next; p != tail; ) {
+                node *nxt = p->next;
+                prefetch_next(p);
+                size_t h = static_cast<size_t>(hash(*(p->val)));
+                // fibonacci hashing spreads user hashes that differ only in high bits
+                size_t i = static_cast<size_t>((static_cast<unsigned long long>(h) * 11400714819323198485ull) >> (64 - bits));
+                bool dup = false;
+                for (; table[i].first != nullptr; i = (i + 1) & mask) {
+                    if (table[i].h == h && *(table[i].first->val) == *(p->val)) {
+                        dup = true;
+                        break;
+                    }
+                }
+                if (dup) {
+                    p->prev->next = nxt;
+                    nxt->prev = p->prev;
+                    p->next = dead;
+                    dead = p;
+                    ++n;
+                } else {
+                    table[i].h = h;
+                    table[i].first = p;
+                }
+                p = nxt;
+            }
+        } catch (...) {
+            delete [] table;
+            sz -= n;
+            destroy_run(dead, n);
+            throw;
+        }
+        delete [] table;
+        sz -= n;
+        destroy_run(dead, n);
+        return n;
+    }
+    /**
+     * remove the elements in [first, last), last may be end()
+     * returns last
+     * throw if an iterator is invalid or last does not follow first
+     */
+    iterator erase(iterator first, iterator last) {
+        if (first.owner != this || last.owner != this || first.cur == nullptr || last.cur == nullptr) throw invalid_iterator();
+        if (first.cur == last.cur) return last;
+        if (first.cur == head || first.cur == tail) throw invalid_iterator();
+        size_t n = 0;
+        for (node *p = first.cur; p != last.cur; p = p->next) {
+            if (p == tail) throw invalid_iterator();
+            ++n;
+        }
+        node *before = first.cur->prev;
+        before->next = last.cur;
+        last.cur->prev = before;
+        sz -= n;
+        destroy_run(first.cur, n);
+        return last;
+    }
+    /**
+     * remove the last / first n elements
+     * throw container_is_empty (removing nothing) when there are fewer than n elements
+     */
+    void pop_back(size_t n) {
+        if (n > sz) throw container_is_empty();
+        if (n == 0) return;
+        node *first = tail;
+        for (size_t i = 0; i < n; ++i) first = first->prev;
+        node *before = first->prev;
+        before->next = tail;
+        tail->prev = before;
+        sz -= n;
+        destroy_run(first, n);
+    }
+    void pop_front(size_t n) {
+        if (n > sz) throw container_is_empty();
+        if (n == 0) return;
+        node *first = head->next;
+        node *p = first;
+        for (size_t i = 0; i < n; ++i) {
+            node *nxt = p->next;
+            prefetch_next(p);
+            destroy_node(p);
+            p = nxt;
+        }
+        head->next = p;
+        p->prev = head;
+        sz -= n;
+    }
     /**
      * sort the values in ascending order with operator< of T
+     * stable; existing ascending / descending runs are exploited (see natural_sort),
+     * so nearly sorted or reversed lists sort in close to linear time.
+     * long lists of integral T are radix sorted instead (see radix_sort)
      */
     void sort() {
         if (sz <= 1) return;
-        node **arr = new node*[sz];
+        sort_values();
+    }
+    /**
+     * stable sort by key(value), compared with operator< of the key type.
+     * key is called once per element and its result cached next to the node (a Schwartzian transform),
+     * so it pays off when comparing T is expensive but a cheaper key exists, or when the key is costly to derive.
+     * no elements are copied or moved, the nodes are relinked
+     */
+    template<typename KeyFn>
+    void sort_by_key(KeyFn key) {
+        if (sz <= 1) return;
+        typedef typename traits::remove_cvref<decltype(key(static_cast<const T &>(*(head->val))))>::type K;
+        struct keyed {
+            K key;
+            node *p;
+        };
+        keyed *items = static_cast<keyed *>(::operator new(sz * sizeof(keyed)));
+        const keyed **order = nullptr;
+        size_t built = 0;
+        try {
+            for (node *p = head->next; p != tail; p = p->next) {
+                prefetch_next(p);
+                ::new (traits::placement(), items + built) keyed{key(static_cast<const T &>(*(p->val))), p};
+                ++built;
+            }
+            order = new const keyed *[sz];
+            for (size_t i = 0; i < sz; ++i) order[i] = items + i;
+            natural_sort(order, sz, [](const keyed *a, const keyed *b) { return a->key < b->key; });
+        } catch (...) {
+            delete [] order;
+            for (size_t i = 0; i < built; ++i) items[i].~keyed();
+            ::operator delete(items);
+            throw;
+        }
+        node *prev = head;
+        for (size_t i = 0; i < sz; ++i) {
+            prev->next = order[i]->p;
+            order[i]->p->prev = prev;
+            prev = order[i]->p;
+        }
+        prev->next = tail;
+        tail->prev = prev;
+        delete [] order;
+        for (size_t i = 0; i < sz; ++i) items[i].~keyed();
+        ::operator delete(items);
+    }
+    /**
+     * stable sort by key(value), which must return an integral type; key is called once per element.
+     * an LSD radix sort (O(n) per key byte that differs between elements) instead of comparisons;
+     * no elements are copied or moved, the nodes are relinked
+     */
+    template<typename KeyFn>
+    void radix_sort(KeyFn key) {
+        if (sz <= 1) return;
+        radix_item *items = new radix_item[sz];
         size_t i = 0;
-        for (node *p = head->next; p != tail; p = p->next) arr[i++] = p;
-        sjtu::sort<node*>(arr, arr + sz, [](node *const &a, node *const &b){ return *(a->val) < *(b->val); });
-        head->next = arr[0];
-        arr[0]->prev = head;
-        for (size_t k = 1; k < sz; ++k) {
-            arr[k-1]->next = arr[k];
-            arr[k]->prev = arr[k-1];
-        }
-        arr[sz-1]->next = tail;
-        tail->prev = arr[sz-1];
-        delete [] arr;
+        try {
+            for (node *p = head->next; p != tail; p = p->next) {
+                prefetch_next(p);
+                items[i].key = radix_key(key(*(p->val)));
+                items[i++].p = p;
+            }
+        } catch (...) {
+            delete [] items;
+            throw;
+        }
+        radix_relink(items);
     }
     /**
      * merge two sorted lists into one (both in ascending order)
@@ -395,45 +1576,257 @@ public:
      * for equivalent elements in the two lists, the elements from *this shall always precede the elements from other
      * the order of equivalent elements of *this and other does not change.
      * no elements are copied or moved
+     * if a comparison throws, both lists stay sorted and valid with their sizes kept right,
+     * the elements already moved staying in *this
      */
     void merge(list &other) {
         if (this == &other || other.sz == 0) return;
+        other.spill();
+        const size_t total = sz + other.sz;
+        const int gallop_after = 7; // consecutive wins of one side before galloping over it
+        int win1 = 0, win2 = 0;
         node *p1 = head->next;
-        node *p2 = other.head->next;
-        while (p1 != tail && p2 != other.tail) {
-            if (*(p2->val) < *(p1->val)) {
-                // detach p2 from other
-                node *n2 = p2->next;
-                p2->prev->next = p2->next;
-                p2->next->prev = p2->prev;
-                // insert p2 before p1
-                p2->prev = p1->prev;
-                p2->next = p1;
-                p1->prev->next = p2;
-                p1->prev = p2;
-                // advance p2
-                p2 = n2;
-                ++sz; --other.sz;
-            } else {
-                p1 = p1->next;
+        try {
+            while (p1 != tail && other.head->next != other.tail) {
+                node *p2 = other.head->next;
+                if (win1 >= gallop_after) {
+                    // skip every element of *this not greater than *p2
+                    win1 = 0;
+                    p1 = gallop(p1, tail, [p2](const node *q) { return !(*(p2->val) < *(q->val)); });
+                } else if (win2 >= gallop_after) {
+                    // move the whole block of other smaller than *p1 with one relink
+                    win2 = 0;
+                    node *stop = gallop(p2, other.tail, [p1](const node *q) { return *(q->val) < *(p1->val); });
+                    if (stop != p2) splice_front(other, stop, p1);
+                } else if (*(p2->val) < *(p1->val)) {
+                    prefetch_next(p2);
+                    splice_front(other, p2->next, p1);
+                    ++win2;
+                    win1 = 0;
+                } else {
+                    prefetch_next(p1);
+                    p1 = p1->next;
+                    ++win1;
+                    win2 = 0;
+                }
             }
+        } catch (...) {
+            // every relink leaves both chains well formed, only the sizes are behind
+            size_t left = 0;
+            for (node *p = other.head->next; p != other.tail; p = p->next) ++left;
+            other.sz = left;
+            sz = total - left;
+            throw;
         }
-        if (p2 != other.tail) {
-            // splice remaining [p2, other.tail->prev] to before tail
-            node *first = p2;
-            node *last = other.tail->prev;
-            // detach from other
+        if (other.head->next != other.tail) splice_front(other, other.tail, tail); // the rest of other follows *this
+        sz = total;
+        other.sz = 0;
+    }
+#ifdef SJTU_LIST_ENABLE_THREADS
+    /**
+     * merge(other) on several threads, with the same result: stable, other becomes empty, nothing copied or moved.
+     * both lists are gathered into node arrays, cut at co-ranked split points (found by binary search
+     * so that every part holds the right prefix of each input), each part is linked by its own thread,
+     * and the parts are stitched together. threads == 0 uses std::thread::hardware_concurrency();
+     * small inputs fall back to merge(). operator< of T must be safe to call concurrently.
+     * if a comparison throws, both lists are restored and the exception is rethrown.
+     */
+    void merge_parallel(list &other, unsigned threads = 0) {
+        if (this == &other || other.sz == 0) return;
+        if (threads == 0) threads = std::thread::hardware_concurrency();
+        const size_t n = sz, m = other.sz, total = n + m;
+        if (threads <= 1 || total < 4096) {
+            merge(other);
+            return;
+        }
+        other.spill();
+        node **a = new node *[n];
+        node **b = new node *[m];
+        size_t i = 0;
+        for (node *p = head->next; p != tail; p = p->next) a[i++] = p;
+        i = 0;
+        for (node *p = other.head->next; p != other.tail; p = p->next) b[i++] = p;
+        // the first r elements of the result are a[0, cut_a(r)) and b[0, r - cut_a(r)), ties going to a
+        auto cut_a = [&](size_t r) {
+            size_t lo = r > m ? r - m : 0, hi = r < n ? r : n;
+            while (lo < hi) {
+                size_t x = lo + (hi - lo) / 2;
+                if (!(*(b[r - x - 1]->val) < *(a[x]->val))) lo = x + 1; // a[x] still precedes b[r - x - 1]
+                else hi = x;
+            }
+            return lo;
+        };
+        node **first = new node *[threads];
+        node **last = new node *[threads];
+        std::exception_ptr *errors = new std::exception_ptr[threads];
+        auto work = [&](unsigned t) {
+            try {
+                size_t r0 = total / threads * t, r1 = t + 1 == threads ? total : total / threads * (t + 1);
+                size_t ia = cut_a(r0), ea = cut_a(r1);
+                size_t ib = r0 - ia, eb = r1 - ea;
+                node *f = nullptr, *prev = nullptr;
+                while (ia < ea || ib < eb) {
+                    node *q;
+                    if (ia == ea) q = b[ib++];
+                    else if (ib == eb || !(*(b[ib]->val) < *(a[ia]->val))) q = a[ia++];
+                    else q = b[ib++];
+                    if (prev) {
+                        prev->next = q;
+                        q->prev = prev;
+                    } else {
+                        f = q;
+                    }
+                    prev = q;
+                }
+                first[t] = f;
+                last[t] = prev;
+            } catch (...) {
+                errors[t] = std::current_exception();
+            }
+        };
+        std::thread *workers = new std::thread[threads - 1];
+        bool *started = new bool[threads - 1];
+        for (unsigned t = 0; t + 1 < threads; ++t) {
+            try {
+                workers[t] = std::thread(work, t);
+                started[t] = true;
+            } catch (...) {
+                started[t] = false;
+            }
+        }
+        work(threads - 1);
+        for (unsigned t = 0; t + 1 < threads; ++t) {
+            if (started[t]) workers[t].join();
+            else work(t); // no thread could be started for this part
+        }
+        std::exception_ptr failure;
+        for (unsigned t = 0; t < threads && !failure; ++t) failure = errors[t];
+        if (failure) {
+            // put both chains back as they were
+            relink_array(head, tail, a, n);
+            relink_array(other.head, other.tail, b, m);
+        } else {
+            node *prev = head;
+            for (unsigned t = 0; t < threads; ++t) {
+                if (first[t] == nullptr) continue;
+                prev->next = first[t];
+                first[t]->prev = prev;
+                prev = last[t];
+            }
+            prev->next = tail;
+            tail->prev = prev;
+            sz = total;
             other.head->next = other.tail;
             other.tail->prev = other.head;
-            size_t moved = 0;
-            for (node *q = first; ; q = q->next) { ++moved; if (q == last) break; }
-            other.sz -= moved; sz += moved;
-            // attach to this
-            last->next = tail;
-            first->prev = tail->prev;
-            tail->prev->next = first;
-            tail->prev = last;
+            other.sz = 0;
+        }
+        delete [] started;
+        delete [] workers;
+        delete [] errors;
+        delete [] last;
+        delete [] first;
+        delete [] b;
+        delete [] a;
+        if (failure) std::rethrow_exception(failure);
+    }
+#endif
+    /**
+     * merge every sorted list of the range [first, last) into *this at once, as repeated merge() would:
+     * the lists in the range become empty, no elements are copied or moved.
+     * equivalent elements keep the order *this, then the lists in range order, each keeping its own order.
+     * the range may hold lists or pointers to lists; *this and repeated lists are skipped.
+     * a heap over the k fronts costs O(n log k) comparisons instead of O(n k) for chained merges.
+     * if a comparison throws, every list stays sorted and valid with its size kept right:
+     * *this holds what was merged so far, then the rest of its own elements; each other list holds its rest
+     */
+    template<typename ListIt>
+    void merge_all(ListIt first, ListIt last) {
+        size_t cnt = 0;
+        for (ListIt it = first; it != last; ++it) ++cnt;
+        list **src = new list *[cnt + 1];
+        size_t k = 0;
+        src[k++] = this;
+        for (ListIt it = first; it != last; ++it) {
+            list *l = &as_list(*it);
+            bool seen = false;
+            for (size_t i = 0; i < k && !seen; ++i) seen = src[i] == l;
+            if (!seen && l->sz) src[k++] = l;
+        }
+        node **pos = new node *[k]; // front of what is left of each source
+        size_t *heap = new size_t[k];
+        size_t total = 0, hs = 0;
+        for (size_t i = 0; i < k; ++i) {
+            if (i) src[i]->spill();
+            total += src[i]->sz;
+            pos[i] = src[i]->head->next;
+            if (pos[i] != src[i]->tail) heap[hs++] = i;
+        }
+        // source i goes before source j: smaller front, ties to the earlier source
+        auto before = [&](size_t i, size_t j) {
+            if (*(pos[i]->val) < *(pos[j]->val)) return true;
+            if (*(pos[j]->val) < *(pos[i]->val)) return false;
+            return i < j;
+        };
+        auto sift_down = [&](size_t h) {
+            for (;;) {
+                size_t c = h * 2 + 1;
+                if (c >= hs) return;
+                if (c + 1 < hs && before(heap[c + 1], heap[c])) ++c;
+                if (!before(heap[c], heap[h])) return;
+                size_t t = heap[c]; heap[c] = heap[h]; heap[h] = t;
+                h = c;
+            }
+        };
+        node *prev = head;
+        try {
+            for (size_t h = hs / 2; h-- > 0; ) sift_down(h);
+            while (hs > 1) {
+                size_t i = heap[0];
+                node *q = pos[i];
+                prefetch_next(q);
+                pos[i] = q->next; // read before q->next is rewritten by the next append
+                prev->next = q;
+                q->prev = prev;
+                prev = q;
+                if (pos[i] == src[i]->tail) heap[0] = heap[--hs];
+                sift_down(0);
+            }
+        } catch (...) {
+            // *this keeps what was merged so far followed by its own rest; every other source keeps its rest
+            prev->next = pos[0];
+            pos[0]->prev = prev;
+            size_t left = 0;
+            for (size_t i = 1; i < k; ++i) {
+                src[i]->head->next = pos[i];
+                pos[i]->prev = src[i]->head;
+                src[i]->sz = 0;
+                for (node *p = pos[i]; p != src[i]->tail; p = p->next) ++src[i]->sz;
+                left += src[i]->sz;
+            }
+            sz = total - left;
+            delete [] heap;
+            delete [] pos;
+            delete [] src;
+            throw;
+        }
+        if (hs == 1) {
+            // the last source left is appended as a whole
+            size_t i = heap[0];
+            prev->next = pos[i];
+            pos[i]->prev = prev;
+            prev = src[i]->tail->prev;
+        }
+        prev->next = tail;
+        tail->prev = prev;
+        sz = total;
+        for (size_t i = 1; i < k; ++i) {
+            src[i]->head->next = src[i]->tail;
+            src[i]->tail->prev = src[i]->head;
+            src[i]->sz = 0;
         }
+        delete [] heap;
+        delete [] pos;
+        delete [] src;
     }
     /**
      * reverse the order of the elements
@@ -441,15 +1834,17 @@ public:
      */
     void reverse() {
         if (sz <= 1) return;
-        node *l = head->next;
-        node *r = tail->prev;
-        for (size_t i = 0; i < sz / 2; ++i) {
-            T *tmp = l->val;
-            l->val = r->val;
-            r->val = tmp;
-            l = l->next;
-            r = r->prev;
+        // relink instead of swapping values: a value may live in storage tied to its node
+        node *first = head->next;
+        node *last = tail->prev;
+        for (node *p = first; p != tail; ) {
+            node *n = p->next;
+            p->next = p->prev;
+            p->prev = n;
+            p = n;
         }
+        head->next = last; last->prev = head;
+        tail->prev = first; first->next = tail;
     }
     /**
      * remove all consecutive duplicate elements from the container
@@ -460,19 +1855,113 @@ public:
         if (sz <= 1) return;
         node *p = head->next;
         while (p != tail) {
+            prefetch_next(p);
             node *n = p->next;
             while (n != tail && !(*(p->val) != *(n->val))) {
+                prefetch_next(n);
                 node *del = n;
                 n = n->next;
                 // unlink del
                 del->prev->next = del->next;
                 del->next->prev = del->prev;
-                delete del;
+                destroy_node(del);
                 --sz;
             }
             p = n;
         }
     }
+    /**
+     * write the size and then every element to os in binary form (see element_codec)
+     * throw runtime_error if the stream fails
+     * save and load are templates only so that a list of a type without a codec can still be instantiated
+     */
+    template<typename U = T>
+    void save(std::ostream &os) const {
+        static_assert(traits::is_same<U, T>::value, "save() takes no template argument");
+        unsigned long long n = sz;
+        os.write(reinterpret_cast<const char *>(&n), sizeof(n));
+        if (element_codec<U>::raw) {
+            const size_t chunk = io_chunk();
+            char *buf = new char[chunk * sizeof(T)];
+            size_t used = 0;
+            for (node *p = head->next; p != tail; p = p->next) {
+                prefetch_next(p);
+                std::memcpy(buf + used * sizeof(T), static_cast<const void *>(p->val), sizeof(T));
+                if (++used == chunk) {
+                    os.write(buf, used * sizeof(T));
+                    used = 0;
+                }
+            }
+            if (used) os.write(buf, used * sizeof(T));
+            delete [] buf;
+        } else {
+            for (node *p = head->next; p != tail; p = p->next) element_codec<U>::encode(os, *(p->val));
+        }
+        if (!os) throw runtime_error();
+    }
+    /**
+     * replace the contents with a list written by save; nodes are allocated in blocks of io_chunk() elements,
+     * so a corrupted or truncated stream fails before any large allocation
+     * (these blocks are shared by their nodes like those of the range constructor)
+     * throw runtime_error if the stream fails or ends early, leaving the list empty
+     */
+    template<typename U = T>
+    void load(std::istream &is) {
+        static_assert(traits::is_same<U, T>::value, "load() takes no template argument");
+        clear();
+        unsigned long long n = 0;
+        if (!is.read(reinterpret_cast<char *>(&n), sizeof(n))) throw runtime_error();
+        const size_t chunk = io_chunk();
+        char *buf = nullptr;
+        try {
+            if (element_codec<U>::raw) buf = new char[chunk * sizeof(T)];
+            while (sz < n) load_block<U>(is, n - sz < chunk ? static_cast<size_t>(n - sz) : chunk, buf);
+        } catch (...) {
+            delete [] buf;
+            clear();
+            throw;
+        }
+        delete [] buf;
+    }
+    /**
+     * move all elements into a single freshly allocated block, laid out in traversal order,
+     * and release the old nodes, so that traversal touches memory sequentially again.
+     * each element is move-constructed once if that cannot throw, copied otherwise;
+     * if a copy throws, the list is left unchanged.
+     * invalidates every iterator except end(); references to elements become dangling.
+     * the new block stays allocated while any of its nodes lives, also in another list after merge() or
+     * extract(), and lists sharing it must not be modified concurrently (see the range constructor).
+     */
+    void compact() {
+        if (sz == 0) return;
+        block *b = allocate_block(sz);
+        slot *s = block_slots(b);
+        size_t i = 0;
+        try {
+            for (node *p = head->next; p != tail; p = p->next, ++i) {
+                prefetch_next(p);
+                relocate_value(&s[i].shell, p->val,
+                               traits::bool_constant<noexcept(T(static_cast<T &&>(*p->val)))>());
+            }
+        } catch (...) {
+            for (size_t k = 0; k < sz; ++k) destroy_block_node(&s[k].shell);
+            throw;
+        }
+        node *p = head->next;
+        node *prev = head;
+        for (i = 0; i < sz; ++i) {
+            prefetch_next(p);
+            node *n = p->next;
+            destroy_node(p);
+            p = n;
+            node *q = &s[i].shell;
+            q->prev = prev;
+            prev->next = q;
+            prev = q;
+        }
+        prev->next = tail;
+        tail->prev = prev;
+    }
 };
 
 }
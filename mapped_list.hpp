@@ -0,0 +1,356 @@
+#ifndef SJTU_MAPPED_LIST_HPP
+#define SJTU_MAPPED_LIST_HPP
+
+#include "exceptions.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace sjtu {
+/**
+ * a doubly-linked list whose nodes live in a memory-mapped file.
+ * links are byte offsets from the start of the mapping instead of pointers,
+ * so a list written by one process is used as is after reopening the file: startup is O(1).
+ * the file grows on demand; erased nodes are kept on a free chain inside the file and reused.
+ * T must be trivially copyable (its bytes are persisted verbatim, in native byte order).
+ * iterators store offsets, so they stay valid when the mapping grows.
+ * POSIX only (mmap); not part of the OJ submission.
+ */
+template<typename T>
+class mapped_list {
+    static_assert(std::is_trivially_copyable<T>::value, "mapped_list stores T by its bytes");
+
+protected:
+    typedef unsigned long long offset_t;
+
+    struct header {
+        char magic[8];
+        offset_t value_size; // sizeof(T) of the writer, checked when reopening
+        offset_t capacity; // bytes of the file
+        offset_t used; // bytes handed out so far, new nodes are taken from here
+        offset_t free_head; // first released node, 0 if none
+        offset_t size;
+        offset_t head; // sentinel head (no value)
+        offset_t tail; // sentinel tail (no value)
+    };
+    struct node {
+        offset_t prev;
+        offset_t next; // also links the free chain
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+    static const offset_t first_node = (sizeof(header) + alignof(node) - 1) / alignof(node) * alignof(node);
+
+    int fd;
+    char *base;
+
+    header *meta() const { return reinterpret_cast<header *>(base); }
+    node *at(offset_t off) const { return reinterpret_cast<node *>(base + off); }
+    T *value(offset_t off) const { return reinterpret_cast<T *>(at(off)->storage); }
+
+    static bool valid_magic(const header *h) { return std::memcmp(h->magic, "SJTULST", 8) == 0; }
+
+    char *map(offset_t bytes) {
+        void *p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) throw runtime_error();
+        return static_cast<char *>(p);
+    }
+    /**
+     * make the file (and the mapping) at least bytes long
+     * the new mapping is made before the old one is dropped, so on failure the list stays usable;
+     * a file longer than its header says (a crash in between) is repaired when reopened.
+     * invalidates raw pointers into the mapping, but not offsets
+     */
+    void grow(offset_t bytes) {
+        offset_t old = meta()->capacity, cap = old;
+        if (bytes <= cap) return;
+        while (cap < bytes) cap *= 2;
+        if (::ftruncate(fd, cap) != 0) throw runtime_error();
+        char *p = map(cap);
+        ::munmap(base, old);
+        base = p;
+        meta()->capacity = cap;
+    }
+    /**
+     * take an unlinked node from the free chain or the unused tail of the file
+     */
+    offset_t allocate() {
+        header *h = meta();
+        if (h->free_head) {
+            offset_t off = h->free_head;
+            h->free_head = at(off)->next;
+            return off;
+        }
+        grow(h->used + sizeof(node));
+        h = meta();
+        offset_t off = h->used;
+        h->used += sizeof(node);
+        return off;
+    }
+    void release(offset_t off) {
+        at(off)->next = meta()->free_head;
+        meta()->free_head = off;
+    }
+    /**
+     * format an empty file
+     */
+    void create() {
+        offset_t cap = first_node + 16 * sizeof(node);
+        if (::ftruncate(fd, cap) != 0) throw runtime_error();
+        base = map(cap);
+        header *h = meta();
+        std::memcpy(h->magic, "SJTULST", 8);
+        h->value_size = sizeof(T);
+        h->capacity = cap;
+        h->free_head = 0;
+        h->size = 0;
+        h->head = first_node;
+        h->tail = first_node + sizeof(node);
+        h->used = first_node + 2 * sizeof(node);
+        at(h->head)->prev = 0; at(h->head)->next = h->tail;
+        at(h->tail)->prev = h->head; at(h->tail)->next = 0;
+    }
+
+public:
+    class const_iterator;
+    class iterator {
+    private:
+        offset_t cur;
+        const mapped_list<T> *owner;
+    public:
+        iterator(): cur(0), owner(nullptr) {}
+        iterator(const mapped_list<T> *o, offset_t c): cur(c), owner(o) {}
+        iterator operator++(int) {
+            iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+        iterator & operator++() {
+            if (owner == nullptr || cur == 0 || cur == owner->meta()->tail) throw invalid_iterator();
+            cur = owner->at(cur)->next;
+            return *this;
+        }
+        iterator operator--(int) {
+            iterator tmp = *this;
+            --*this;
+            return tmp;
+        }
+        iterator & operator--() {
+            if (owner == nullptr || cur == 0) throw invalid_iterator();
+            offset_t p = owner->at(cur)->prev;
+            if (p == 0 || p == owner->meta()->head) throw invalid_iterator();
+            cur = p;
+            return *this;
+        }
+        T & operator *() const {
+            if (owner == nullptr || cur == 0 || cur == owner->meta()->tail) throw invalid_iterator();
+            return *owner->value(cur);
+        }
+        T * operator ->() const {
+            if (owner == nullptr || cur == 0 || cur == owner->meta()->tail) throw invalid_iterator();
+            return owner->value(cur);
+        }
+        bool operator==(const iterator &rhs) const { return owner == rhs.owner && cur == rhs.cur; }
+        bool operator==(const const_iterator &rhs) const { return owner == rhs.owner && cur == rhs.cur; }
+        bool operator!=(const iterator &rhs) const { return !(*this == rhs); }
+        bool operator!=(const const_iterator &rhs) const { return !(*this == rhs); }
+
+        friend class mapped_list<T>;
+    };
+    class const_iterator {
+    private:
+        offset_t cur;
+        const mapped_list<T> *owner;
+    public:
+        const_iterator(): cur(0), owner(nullptr) {}
+        const_iterator(const mapped_list<T> *o, offset_t c): cur(c), owner(o) {}
+        const_iterator(const iterator &it): cur(it.cur), owner(it.owner) {}
+        const_iterator operator++(int) {
+            const_iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+        const_iterator & operator++() {
+            if (owner == nullptr || cur == 0 || cur == owner->meta()->tail) throw invalid_iterator();
+            cur = owner->at(cur)->next;
+            return *this;
+        }
+        const_iterator operator--(int) {
+            const_iterator tmp = *this;
+            --*this;
+            return tmp;
+        }
+        const_iterator & operator--() {
+            if (owner == nullptr || cur == 0) throw invalid_iterator();
+            offset_t p = owner->at(cur)->prev;
+            if (p == 0 || p == owner->meta()->head) throw invalid_iterator();
+            cur = p;
+            return *this;
+        }
+        const T & operator *() const {
+            if (owner == nullptr || cur == 0 || cur == owner->meta()->tail) throw invalid_iterator();
+            return *owner->value(cur);
+        }
+        const T * operator ->() const {
+            if (owner == nullptr || cur == 0 || cur == owner->meta()->tail) throw invalid_iterator();
+            return owner->value(cur);
+        }
+        bool operator==(const const_iterator &rhs) const { return owner == rhs.owner && cur == rhs.cur; }
+        bool operator==(const iterator &rhs) const { return owner == rhs.owner && cur == rhs.cur; }
+        bool operator!=(const const_iterator &rhs) const { return !(*this == rhs); }
+        bool operator!=(const iterator &rhs) const { return !(*this == rhs); }
+
+        friend class mapped_list<T>;
+    };
+
+    /**
+     * open the list stored in path, creating an empty one if the file does not exist or is empty
+     * a file grown past the capacity in its header (interrupted growth) is accepted and the header updated
+     * throw runtime_error if the file cannot be mapped or was written for another element size
+     */
+    explicit mapped_list(const char *path): fd(-1), base(nullptr) {
+        fd = ::open(path, O_RDWR | O_CREAT, 0644);
+        if (fd < 0) throw runtime_error();
+        try {
+            struct stat st;
+            if (::fstat(fd, &st) != 0) throw runtime_error();
+            if (st.st_size == 0) {
+                create();
+                return;
+            }
+            if (static_cast<offset_t>(st.st_size) < first_node + 2 * sizeof(node)) throw runtime_error();
+            const offset_t bytes = st.st_size;
+            base = map(bytes);
+            header *h = meta();
+            if (!valid_magic(h) || h->value_size != sizeof(T) || h->capacity > bytes || h->used > h->capacity) {
+                ::munmap(base, bytes);
+                base = nullptr;
+                throw runtime_error();
+            }
+            h->capacity = bytes;
+        } catch (...) {
+            ::close(fd);
+            throw;
+        }
+    }
+    mapped_list(const mapped_list &) = delete;
+    mapped_list &operator=(const mapped_list &) = delete;
+    /**
+     * unmap and close; the contents stay in the file
+     */
+    ~mapped_list() {
+        ::munmap(base, meta()->capacity);
+        ::close(fd);
+    }
+    /**
+     * flush the mapping to the file synchronously
+     */
+    void sync() {
+        if (::msync(base, meta()->capacity, MS_SYNC) != 0) throw runtime_error();
+    }
+
+    const T & front() const {
+        if (meta()->size == 0) throw container_is_empty();
+        return *value(at(meta()->head)->next);
+    }
+    const T & back() const {
+        if (meta()->size == 0) throw container_is_empty();
+        return *value(at(meta()->tail)->prev);
+    }
+    iterator begin() { return iterator(this, at(meta()->head)->next); }
+    const_iterator cbegin() const { return const_iterator(this, at(meta()->head)->next); }
+    iterator end() { return iterator(this, meta()->tail); }
+    const_iterator cend() const { return const_iterator(this, meta()->tail); }
+    bool empty() const { return meta()->size == 0; }
+    size_t size() const { return meta()->size; }
+
+    /**
+     * erase every element; the space stays in the file for reuse
+     */
+    void clear() {
+        header *h = meta();
+        offset_t p = at(h->head)->next;
+        while (p != h->tail) {
+            offset_t n = at(p)->next;
+            release(p);
+            p = n;
+        }
+        at(h->head)->next = h->tail;
+        at(h->tail)->prev = h->head;
+        h->size = 0;
+    }
+    /**
+     * insert value before pos (pos may be the end() iterator)
+     * return an iterator pointing to the inserted value
+     * throw if the iterator is invalid
+     */
+    iterator insert(iterator pos, const T &value) {
+        if (pos.owner != this || pos.cur == 0 || pos.cur == meta()->head) throw invalid_iterator();
+        T copy(value); // value may live in the mapping, which allocate() can move
+        offset_t off = allocate();
+        node *nd = at(off);
+        ::new (nd->storage) T(copy);
+        node *p = at(pos.cur);
+        nd->prev = p->prev;
+        nd->next = pos.cur;
+        at(p->prev)->next = off;
+        p->prev = off;
+        ++meta()->size;
+        return iterator(this, off);
+    }
+    /**
+     * remove the element at pos (the end() iterator is invalid)
+     * returns an iterator pointing to the following element
+     * throw if the container is empty, the iterator is invalid
+     */
+    iterator erase(iterator pos) {
+        if (pos.owner != this || pos.cur == 0) throw invalid_iterator();
+        if (meta()->size == 0) throw container_is_empty();
+        if (pos.cur == meta()->tail || pos.cur == meta()->head) throw invalid_iterator();
+        node *p = at(pos.cur);
+        offset_t nxt = p->next;
+        at(p->prev)->next = p->next;
+        at(p->next)->prev = p->prev;
+        release(pos.cur);
+        --meta()->size;
+        return iterator(this, nxt);
+    }
+    void push_back(const T &value) { insert(end(), value); }
+    void pop_back() {
+        if (meta()->size == 0) throw container_is_empty();
+        erase(iterator(this, at(meta()->tail)->prev));
+    }
+    void push_front(const T &value) { insert(begin(), value); }
+    void pop_front() {
+        if (meta()->size == 0) throw container_is_empty();
+        erase(iterator(this, at(meta()->head)->next));
+    }
+    /**
+     * reverse the order of the elements by relinking
+     */
+    void reverse() {
+        header *h = meta();
+        if (h->size <= 1) return;
+        offset_t first = at(h->head)->next;
+        offset_t last = at(h->tail)->prev;
+        for (offset_t p = first; p != h->tail; ) {
+            node *cur = at(p);
+            offset_t n = cur->next;
+            cur->next = cur->prev;
+            cur->prev = n;
+            p = n;
+        }
+        at(h->head)->next = last; at(last)->prev = h->head;
+        at(h->tail)->prev = first; at(first)->next = h->tail;
+    }
+};
+
+}
+
+#endif //SJTU_MAPPED_LIST_HPP
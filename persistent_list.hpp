@@ -0,0 +1,264 @@
+#ifndef SJTU_PERSISTENT_LIST_HPP
+#define SJTU_PERSISTENT_LIST_HPP
+
+#include "exceptions.hpp"
+
+#include <cstddef>
+
+namespace sjtu {
+/**
+ * an immutable sequence whose versions share structure.
+ * every "modifier" (push / pop / insert / erase / set) leaves *this untouched and returns a new version
+ * in O(log n) expected time, creating only O(log n) new nodes; all other nodes are shared with *this.
+ * so N versions that differ by a few operations cost about one sequence plus O(log n) nodes per operation.
+ * copying a version is O(1).
+ * internally the sequence is the in-order walk of a randomized binary tree: join picks the root of two trees
+ * at random, weighted by their sizes. stored priorities would not do, since versions share nodes
+ * and p.concat(p) would then join two trees with equal priorities into a chain.
+ * nodes and values are reference counted and freed with the last version using them.
+ * reference counts are not atomic: versions must stay on one thread.
+ */
+template<typename T>
+class persistent_list {
+protected:
+    /**
+     * an element, shared by every copy of the nodes holding it
+     */
+    struct cell {
+        T val;
+        size_t refs;
+        explicit cell(const T &value): val(value), refs(1) {}
+    };
+    class node {
+    public:
+        cell *data;
+        node *left;
+        node *right;
+        size_t size; // nodes in this subtree
+        size_t refs; // versions and parent nodes pointing here
+    };
+
+    node *root;
+
+    static size_t size_of(const node *t) { return t ? t->size : 0; }
+    static node *retain(node *t) {
+        if (t) ++t->refs;
+        return t;
+    }
+    static void release(node *t) {
+        if (t == nullptr || --t->refs) return;
+        if (--t->data->refs == 0) delete t->data;
+        release(t->left);
+        release(t->right);
+        delete t;
+    }
+    static unsigned long long next_random() {
+        static unsigned long long state = 88172645463325252ULL; // xorshift64
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+    /**
+     * a new node (one reference, owned by the caller) sharing data and both children
+     */
+    static node *make(cell *data, node *left, node *right) {
+        node *t = new node;
+        t->data = data; ++data->refs;
+        t->left = retain(left);
+        t->right = retain(right);
+        t->size = size_of(left) + size_of(right) + 1;
+        t->refs = 1;
+        return t;
+    }
+    /**
+     * split the sequence t into its first k elements (a) and the rest (b)
+     * t is only read; a and b are new references owned by the caller
+     */
+    static void split(node *t, size_t k, node *&a, node *&b) {
+        if (t == nullptr) {
+            a = b = nullptr;
+            return;
+        }
+        node *l, *r;
+        size_t ls = size_of(t->left);
+        if (k <= ls) {
+            split(t->left, k, l, r);
+            b = make(t->data, r, t->right);
+            release(r);
+            a = l;
+        } else {
+            split(t->right, k - ls - 1, l, r);
+            a = make(t->data, t->left, l);
+            release(l);
+            b = r;
+        }
+    }
+    /**
+     * concatenate a and b; both are only read, the result is a new reference owned by the caller.
+     * the root of a becomes the root with probability size(a) / (size(a) + size(b)),
+     * which keeps the expected depth O(log n) whatever the inputs share
+     */
+    static node *join(node *a, node *b) {
+        if (a == nullptr) return retain(b);
+        if (b == nullptr) return retain(a);
+        node *res;
+        if (next_random() % (a->size + b->size) < a->size) {
+            node *r = join(a->right, b);
+            res = make(a->data, a->left, r);
+            release(r);
+        } else {
+            node *l = join(a, b->left);
+            res = make(b->data, l, b->right);
+            release(l);
+        }
+        return res;
+    }
+    static const T &at(const node *t, size_t k) {
+        for (;;) {
+            size_t ls = size_of(t->left);
+            if (k == ls) return t->data->val;
+            if (k < ls) {
+                t = t->left;
+            } else {
+                k -= ls + 1;
+                t = t->right;
+            }
+        }
+    }
+    /**
+     * adopt a root already owned by the caller
+     */
+    explicit persistent_list(node *r): root(r) {}
+
+public:
+    /**
+     * a read-only iterator; it stays valid as long as its version exists, since versions never change.
+     * it stores an index, so dereferencing costs O(log n)
+     */
+    class const_iterator {
+    private:
+        const persistent_list<T> *owner;
+        size_t idx;
+    public:
+        const_iterator(): owner(nullptr), idx(0) {}
+        const_iterator(const persistent_list<T> *o, size_t i): owner(o), idx(i) {}
+        const_iterator operator++(int) {
+            const_iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+        const_iterator & operator++() {
+            if (owner == nullptr || idx >= owner->size()) throw invalid_iterator();
+            ++idx;
+            return *this;
+        }
+        const_iterator operator--(int) {
+            const_iterator tmp = *this;
+            --*this;
+            return tmp;
+        }
+        const_iterator & operator--() {
+            if (owner == nullptr || idx == 0) throw invalid_iterator();
+            --idx;
+            return *this;
+        }
+        const T & operator *() const {
+            if (owner == nullptr || idx >= owner->size()) throw invalid_iterator();
+            return at(owner->root, idx);
+        }
+        const T * operator ->() const { return &**this; }
+        bool operator==(const const_iterator &rhs) const { return owner == rhs.owner && idx == rhs.idx; }
+        bool operator!=(const const_iterator &rhs) const { return !(*this == rhs); }
+    };
+
+    persistent_list(): root(nullptr) {}
+    persistent_list(const persistent_list &other): root(retain(other.root)) {}
+    ~persistent_list() { release(root); }
+    persistent_list &operator=(const persistent_list &other) {
+        node *old = root;
+        root = retain(other.root);
+        release(old);
+        return *this;
+    }
+
+    /**
+     * access the first / last / k-th element
+     * throw container_is_empty when the container is empty, index_out_of_bound for a bad k
+     */
+    const T & front() const {
+        if (root == nullptr) throw container_is_empty();
+        return at(root, 0);
+    }
+    const T & back() const {
+        if (root == nullptr) throw container_is_empty();
+        return at(root, root->size - 1);
+    }
+    const T & operator[](size_t k) const {
+        if (k >= size()) throw index_out_of_bound();
+        return at(root, k);
+    }
+    const_iterator cbegin() const { return const_iterator(this, 0); }
+    const_iterator cend() const { return const_iterator(this, size()); }
+    bool empty() const { return root == nullptr; }
+    size_t size() const { return size_of(root); }
+
+    /**
+     * the version with value inserted before the k-th element (k == size() appends)
+     * throw index_out_of_bound if k > size()
+     */
+    persistent_list insert(size_t k, const T &value) const {
+        if (k > size()) throw index_out_of_bound();
+        cell *c = new cell(value);
+        node *leaf = make(c, nullptr, nullptr);
+        --c->refs; // now held by leaf only
+        node *a, *b;
+        split(root, k, a, b);
+        node *ab = join(a, leaf);
+        node *res = join(ab, b);
+        release(a); release(b); release(leaf); release(ab);
+        return persistent_list(res);
+    }
+    /**
+     * the version without the k-th element
+     * throw index_out_of_bound if k >= size()
+     */
+    persistent_list erase(size_t k) const {
+        if (k >= size()) throw index_out_of_bound();
+        node *a, *rest, *mid, *b;
+        split(root, k, a, rest);
+        split(rest, 1, mid, b);
+        node *res = join(a, b);
+        release(a); release(rest); release(mid); release(b);
+        return persistent_list(res);
+    }
+    /**
+     * the version with the k-th element replaced by value
+     */
+    persistent_list set(size_t k, const T &value) const {
+        return erase(k).insert(k, value);
+    }
+    persistent_list push_back(const T &value) const { return insert(size(), value); }
+    persistent_list push_front(const T &value) const { return insert(0, value); }
+    /**
+     * throw container_is_empty when the container is empty
+     */
+    persistent_list pop_back() const {
+        if (root == nullptr) throw container_is_empty();
+        return erase(size() - 1);
+    }
+    persistent_list pop_front() const {
+        if (root == nullptr) throw container_is_empty();
+        return erase(0);
+    }
+    /**
+     * the concatenation of *this and other, sharing the nodes of both
+     */
+    persistent_list concat(const persistent_list &other) const {
+        return persistent_list(join(root, other.root));
+    }
+};
+
+}
+
+#endif //SJTU_PERSISTENT_LIST_HPP
@@ -0,0 +1,143 @@
+#ifndef SJTU_SMALL_LIST_HPP
+#define SJTU_SMALL_LIST_HPP
+
+#include "list.hpp"
+
+#include <cstddef>
+
+namespace sjtu {
+/**
+ * a list keeping its first N nodes (and their values) in a buffer inside the object.
+ * only elements beyond the N-th are allocated on the heap, so short lists cost no allocation at all.
+ * all operations of list are available.
+ * when nodes are handed over to another list (merge, extract), the buffered ones are moved to the heap first.
+ */
+template<typename T, size_t N = 8>
+class small_list : public list<T> {
+    static_assert(N > 0, "small_list needs a non-empty buffer");
+
+protected:
+    typedef typename list<T>::node node;
+    typedef typename list<T>::slot slot;
+
+    slot buf[N];
+    node *buf_free; // unused buffered nodes, chained by next
+
+    bool buffered(node *cur) const {
+        const slot *s = reinterpret_cast<const slot *>(cur);
+        return s >= buf && s < buf + N;
+    }
+    void init_buffer() {
+        for (size_t i = 0; i + 1 < N; ++i) buf[i].shell.next = &buf[i + 1].shell;
+        buf[N - 1].shell.next = nullptr;
+        buf_free = &buf[0].shell;
+    }
+
+    node *create_node(const T &value) override {
+        if (buf_free == nullptr) return list<T>::create_node(value);
+        node *cur = buf_free;
+        list<T>::construct_value(cur, value);
+        buf_free = cur->next;
+        cur->next = nullptr;
+        return cur;
+    }
+    void destroy_node(node *cur) override {
+        if (!buffered(cur)) {
+            list<T>::destroy_node(cur);
+            return;
+        }
+        cur->val->~T();
+        cur->val = nullptr;
+        cur->prev = nullptr;
+        cur->next = buf_free;
+        buf_free = cur;
+    }
+    /**
+     * replace every buffered node by a heap node, moving its value
+     */
+    void spill() override {
+        for (node *p = this->head->next; p != this->tail; ) {
+            node *n = p->next;
+            if (buffered(p)) {
+                node *h = new node(static_cast<T &&>(*(p->val)));
+                h->prev = p->prev;
+                h->next = n;
+                p->prev->next = h;
+                n->prev = h;
+                destroy_node(p);
+            }
+            p = n;
+        }
+    }
+    /**
+     * an extracted buffered node is moved to the heap, as in spill
+     */
+    node *detach_node(node *cur) override {
+        if (!buffered(cur)) return cur;
+        node *h = new node(static_cast<T &&>(*(cur->val)));
+        destroy_node(cur);
+        return h;
+    }
+
+public:
+    small_list(): list<T>() { init_buffer(); }
+    small_list(const small_list &other): list<T>() {
+        init_buffer();
+        for (typename list<T>::const_iterator it = other.cbegin(); it != other.cend(); ++it) this->push_back(*it);
+    }
+    explicit small_list(const list<T> &other): list<T>() {
+        init_buffer();
+        for (typename list<T>::const_iterator it = other.cbegin(); it != other.cend(); ++it) this->push_back(*it);
+    }
+    /**
+     * as the constructors of list, but the first N elements go to the buffer.
+     * if a copy throws, the buffered nodes are released here, before ~list could see them
+     */
+    template<typename InputIt, typename = typename traits::enable_if<!traits::is_integral<InputIt>::value>::type>
+    small_list(InputIt first, InputIt last): list<T>() {
+        init_buffer();
+        try {
+            for (; first != last; ++first) this->push_back(*first);
+        } catch (...) {
+            this->clear();
+            throw;
+        }
+    }
+    small_list(size_t n, const T &value): list<T>() {
+        init_buffer();
+        try {
+            for (size_t i = 0; i < n; ++i) this->push_back(value);
+        } catch (...) {
+            this->clear();
+            throw;
+        }
+    }
+#ifdef SJTU_LIST_ENABLE_INITIALIZER_LIST
+    small_list(std::initializer_list<T> il): small_list(il.begin(), il.end()) {}
+#endif
+    /**
+     * buffered nodes must be released while this part of the object is still alive
+     */
+    ~small_list() { this->clear(); }
+
+    small_list &operator=(const small_list &other) {
+        list<T>::operator=(other);
+        return *this;
+    }
+    small_list &operator=(const list<T> &other) {
+        list<T>::operator=(other);
+        return *this;
+    }
+    /**
+     * number of elements that can still be added without a heap allocation
+     */
+    size_t inline_available() const {
+        size_t cnt = 0;
+        for (node *p = buf_free; p != nullptr; p = p->next) ++cnt;
+        return cnt;
+    }
+};
+
+}
+
+#endif //SJTU_SMALL_LIST_HPP
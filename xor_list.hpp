@@ -0,0 +1,269 @@
+#ifndef SJTU_XOR_LIST_HPP
+#define SJTU_XOR_LIST_HPP
+
+#include "exceptions.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace sjtu {
+/**
+ * a doubly-linked list storing one link per node: the xor of the addresses of its two neighbours.
+ * a node is that word followed by the value, in one allocation, which makes it 24 bytes smaller
+ * than a node of list; the cost is that a node cannot be reached from its address alone.
+ * so iterators carry two pointers (the previous node and the current one) and walk in both directions,
+ * and insert / erase work at iterator positions and at both ends only.
+ * insert and erase invalidate the iterators to pos and to its neighbours, since their pairs change;
+ * other iterators stay valid. reverse() is O(1).
+ */
+template<typename T>
+class xor_list {
+protected:
+    struct link_node {
+        std::uintptr_t link; // address of prev xor address of next; the sentinels have one neighbour
+        link_node(): link(0) {}
+    };
+    struct node : link_node {
+        T val;
+        explicit node(const T &value): link_node(), val(value) {}
+    };
+
+    link_node sentinel[2];
+    link_node *head; // before the first element
+    link_node *tail; // after the last element, end()
+    size_t sz;
+
+    static std::uintptr_t addr(const link_node *p) { return reinterpret_cast<std::uintptr_t>(p); }
+    /**
+     * the neighbour of cur on the other side from prev
+     */
+    static link_node *step(const link_node *prev, const link_node *cur) {
+        return reinterpret_cast<link_node *>(cur->link ^ addr(prev));
+    }
+    static T &value(link_node *cur) { return static_cast<node *>(cur)->val; }
+
+    void init() {
+        head = &sentinel[0];
+        tail = &sentinel[1];
+        head->link = addr(tail);
+        tail->link = addr(head);
+        sz = 0;
+    }
+    /**
+     * link a new node holding value between the adjacent prev and next
+     */
+    link_node *insert(link_node *prev, link_node *next, const T &value) {
+        node *n = new node(value);
+        n->link = addr(prev) ^ addr(next);
+        prev->link ^= addr(next) ^ addr(n);
+        next->link ^= addr(prev) ^ addr(n);
+        ++sz;
+        return n;
+    }
+    /**
+     * unlink and free cur, which lies between prev and the returned node
+     */
+    link_node *erase(link_node *prev, link_node *cur) {
+        link_node *next = step(prev, cur);
+        prev->link ^= addr(cur) ^ addr(next);
+        next->link ^= addr(cur) ^ addr(prev);
+        delete static_cast<node *>(cur);
+        --sz;
+        return next;
+    }
+
+public:
+    class const_iterator;
+    class iterator {
+    private:
+        link_node *prev;
+        link_node *cur;
+        const xor_list<T> *owner;
+    public:
+        iterator(): prev(nullptr), cur(nullptr), owner(nullptr) {}
+        iterator(const xor_list<T> *o, link_node *p, link_node *c): prev(p), cur(c), owner(o) {}
+        iterator operator++(int) {
+            iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+        iterator & operator++() {
+            if (owner == nullptr || cur == nullptr || cur == owner->tail) throw invalid_iterator();
+            link_node *n = step(prev, cur);
+            prev = cur;
+            cur = n;
+            return *this;
+        }
+        iterator operator--(int) {
+            iterator tmp = *this;
+            --*this;
+            return tmp;
+        }
+        /**
+         * decrement from begin() is invalid; decrement from end() allowed only if list not empty
+         */
+        iterator & operator--() {
+            if (owner == nullptr || cur == nullptr || prev == owner->head) throw invalid_iterator();
+            link_node *p = step(cur, prev);
+            cur = prev;
+            prev = p;
+            return *this;
+        }
+        T & operator *() const {
+            if (owner == nullptr || cur == nullptr || cur == owner->tail) throw invalid_iterator();
+            return value(cur);
+        }
+        T * operator ->() const {
+            if (owner == nullptr || cur == nullptr || cur == owner->tail) throw invalid_iterator();
+            return &value(cur);
+        }
+        bool operator==(const iterator &rhs) const { return cur == rhs.cur; }
+        bool operator==(const const_iterator &rhs) const { return cur == rhs.cur; }
+        bool operator!=(const iterator &rhs) const { return !(*this == rhs); }
+        bool operator!=(const const_iterator &rhs) const { return !(*this == rhs); }
+
+        friend class xor_list<T>;
+    };
+    class const_iterator {
+    private:
+        const link_node *prev;
+        const link_node *cur;
+        const xor_list<T> *owner;
+    public:
+        const_iterator(): prev(nullptr), cur(nullptr), owner(nullptr) {}
+        const_iterator(const xor_list<T> *o, const link_node *p, const link_node *c): prev(p), cur(c), owner(o) {}
+        const_iterator(const iterator &it): prev(it.prev), cur(it.cur), owner(it.owner) {}
+        const_iterator operator++(int) {
+            const_iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+        const_iterator & operator++() {
+            if (owner == nullptr || cur == nullptr || cur == owner->tail) throw invalid_iterator();
+            const link_node *n = step(prev, cur);
+            prev = cur;
+            cur = n;
+            return *this;
+        }
+        const_iterator operator--(int) {
+            const_iterator tmp = *this;
+            --*this;
+            return tmp;
+        }
+        const_iterator & operator--() {
+            if (owner == nullptr || cur == nullptr || prev == owner->head) throw invalid_iterator();
+            const link_node *p = step(cur, prev);
+            cur = prev;
+            prev = p;
+            return *this;
+        }
+        const T & operator *() const {
+            if (owner == nullptr || cur == nullptr || cur == owner->tail) throw invalid_iterator();
+            return static_cast<const node *>(cur)->val;
+        }
+        const T * operator ->() const {
+            if (owner == nullptr || cur == nullptr || cur == owner->tail) throw invalid_iterator();
+            return &static_cast<const node *>(cur)->val;
+        }
+        bool operator==(const const_iterator &rhs) const { return cur == rhs.cur; }
+        bool operator==(const iterator &rhs) const { return cur == rhs.cur; }
+        bool operator!=(const const_iterator &rhs) const { return !(*this == rhs); }
+        bool operator!=(const iterator &rhs) const { return !(*this == rhs); }
+
+        friend class xor_list<T>;
+    };
+
+    xor_list() { init(); }
+    xor_list(const xor_list &other) {
+        init();
+        try {
+            for (const_iterator it = other.cbegin(); it != other.cend(); ++it) push_back(*it);
+        } catch (...) {
+            clear();
+            throw;
+        }
+    }
+    ~xor_list() { clear(); }
+    xor_list &operator=(const xor_list &other) {
+        if (this == &other) return *this;
+        clear();
+        for (const_iterator it = other.cbegin(); it != other.cend(); ++it) push_back(*it);
+        return *this;
+    }
+
+    /**
+     * access the first / last element
+     * throw container_is_empty when the container is empty.
+     */
+    const T & front() const {
+        if (sz == 0) throw container_is_empty();
+        return static_cast<const node *>(step(nullptr, head))->val;
+    }
+    const T & back() const {
+        if (sz == 0) throw container_is_empty();
+        return static_cast<const node *>(step(nullptr, tail))->val;
+    }
+    iterator begin() { return iterator(this, head, step(nullptr, head)); }
+    const_iterator cbegin() const { return const_iterator(this, head, step(nullptr, head)); }
+    iterator end() { return iterator(this, step(nullptr, tail), tail); }
+    const_iterator cend() const { return const_iterator(this, step(nullptr, tail), tail); }
+    bool empty() const { return sz == 0; }
+    size_t size() const { return sz; }
+
+    void clear() {
+        link_node *prev = head, *cur = step(nullptr, head);
+        while (cur != tail) {
+            link_node *n = step(prev, cur);
+            delete static_cast<node *>(cur);
+            prev = cur;
+            cur = n;
+        }
+        init();
+    }
+    /**
+     * insert value before pos (pos may be the end() iterator)
+     * return an iterator pointing to the inserted value
+     * throw if the iterator is invalid
+     */
+    iterator insert(iterator pos, const T &value) {
+        if (pos.owner != this || pos.cur == nullptr) throw invalid_iterator();
+        return iterator(this, pos.prev, insert(pos.prev, pos.cur, value));
+    }
+    /**
+     * remove the element at pos (the end() iterator is invalid)
+     * returns an iterator pointing to the following element
+     * throw if the container is empty, the iterator is invalid
+     */
+    iterator erase(iterator pos) {
+        if (pos.owner != this || pos.cur == nullptr) throw invalid_iterator();
+        if (sz == 0) throw container_is_empty();
+        if (pos.cur == tail) throw invalid_iterator();
+        return iterator(this, pos.prev, erase(pos.prev, pos.cur));
+    }
+    void push_back(const T &value) { insert(step(nullptr, tail), tail, value); }
+    void push_front(const T &value) { insert(head, step(nullptr, head), value); }
+    /**
+     * throw when the container is empty.
+     */
+    void pop_back() {
+        if (sz == 0) throw container_is_empty();
+        erase(tail, step(nullptr, tail));
+    }
+    void pop_front() {
+        if (sz == 0) throw container_is_empty();
+        erase(head, step(nullptr, head));
+    }
+    /**
+     * reverse the order of the elements in O(1): a xor link reads the same in both directions,
+     * so exchanging the roles of the sentinels is enough. invalidates all iterators
+     */
+    void reverse() {
+        link_node *t = head;
+        head = tail;
+        tail = t;
+    }
+};
+
+}
+
+#endif //SJTU_XOR_LIST_HPP